@@ -159,7 +159,7 @@ int main(int argc, char** argv) {
 
   std::string ozHomeStr, initFunctorPathStr, baseFunctorPathStr;
   fs::path ozHome, initFunctorPath, baseFunctorPath;
-  std::string ozSearchPath, ozSearchLoad, appURL;
+  std::string ozSearchPath, ozSearchLoad, appURL, profileFileStr;
   std::vector<std::string> appArgs;
   size_t minMemoryMega = 32;
 #if defined(_WIN32) && !defined(_WIN64)
@@ -168,6 +168,7 @@ int main(int argc, char** argv) {
   size_t maxMemoryMega = 768;
 #endif
   bool appGUI;
+  nativeint profileInterval = 10;
 
   // DEFINE OPTIONS
 
@@ -189,7 +190,12 @@ int main(int argc, char** argv) {
       "minimal heap size in MB")
     ("max-memory", po::value<size_t>(&maxMemoryMega),
       "maximum heap size in MB")
-    ("gui", "GUI mode");
+    ("gui", "GUI mode")
+    ("profile", po::value<std::string>(&profileFileStr),
+      "sample the running Oz threads and write the collapsed stacks to the "
+      "given file when the VM terminates")
+    ("profile-interval", po::value<nativeint>(&profileInterval),
+      "interval between two profiling samples in ms");
 
   po::options_description hidden("Hidden options");
   hidden.add_options()
@@ -290,6 +296,9 @@ int main(int argc, char** argv) {
 
   appGUI = varMap.count("gui") != 0;
 
+  bool useProfiler = !profileFileStr.empty();
+  fs::path profileFile = profileFileStr;
+
   // SET UP THE VM AND RUN
   boostenv::BoostEnvironment boostEnv([=] (VM vm, std::unique_ptr<std::string> app, bool isURL) {
     boostenv::BoostVM& boostVM = boostenv::BoostVM::forVM(vm);
@@ -341,6 +350,9 @@ int main(int argc, char** argv) {
 
     boostenv::BoostEnvironment& boostEnv = boostenv::BoostEnvironment::forVM(vm);
 
+    if (useProfiler)
+      vm->getProfiler().start(profileInterval);
+
     // Some protected nodes
     ProtectedNode baseEnv, initFunctor;
 
@@ -418,6 +430,19 @@ int main(int argc, char** argv) {
       boostVM.run();
     }
 
+    // Write the profile, suffixed by the VM identifier except for the first VM
+    if (useProfiler) {
+      fs::path path = profileFile;
+      if (boostVM.identifier != 1)
+        path += "." + std::to_string(boostVM.identifier);
+
+      fs::ofstream output(path);
+      if (output)
+        vm->getProfiler().dumpCollapsed(output);
+      else
+        std::cerr << "could not write the profile to " << path << std::endl;
+    }
+
     return true;
   });
 
@@ -39,6 +39,9 @@
 
 #include "boostvm-decl.hh"
 #include "boostenvbigint-decl.hh"
+#include "boostenvsharedtable-decl.hh"
+#include "boostenvfileio-decl.hh"
+#include "boostenvresolver-decl.hh"
 
 namespace mozart { namespace boostenv {
 
@@ -63,6 +66,9 @@ public:
   inline
   BoostEnvironment(const VMStarter& vmStarter);
 
+  inline
+  ~BoostEnvironment();
+
 // VM Management
 
 public:
@@ -183,6 +189,31 @@ public:
     BoostVM::forVM(gc->vm).gCollect(gc);
   }
 
+// File I/O
+
+public:
+  /**
+   * Runs a blocking file operation on the file I/O thread pool
+   * The pool is started by the first operation. The task must not touch any
+   * VM, and reports its result to the VM with postVMEvent().
+   */
+  inline
+  void postFileIOTask(std::function<void()> task);
+
+// Host name resolution
+
+public:
+  HostResolver& getHostResolver() {
+    return _hostResolver;
+  }
+
+// Shared tables
+
+public:
+  SharedTableRegistry& getSharedTables() {
+    return _sharedTables;
+  }
+
 // Unsafe process-wide operations
 
 public:
@@ -203,6 +234,23 @@ private:
 public:
   VMStarter vmStarter;
 
+// File I/O
+private:
+  static const unsigned int FileIOThreadCount = 4;
+
+  boost::asio::io_service _fileIOService;
+  std::unique_ptr<boost::asio::io_service::work> _fileIOWork;
+  boost::thread_group _fileIOThreads;
+  boost::mutex _fileIOMutex;
+
+// Host name resolution
+private:
+  HostResolver _hostResolver;
+
+// Shared tables
+private:
+  SharedTableRegistry _sharedTables;
+
 // Unsafe process-wide operations
 private:
   boost::mutex _environmentVariablesMutex;
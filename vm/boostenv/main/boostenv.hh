@@ -36,6 +36,9 @@
 #include "boostenvtcp.hh"
 #include "boostenvpipe.hh"
 #include "boostenvbigint.hh"
+#include "boostenvsharedtable.hh"
+#include "boostenvfileio.hh"
+#include "boostenvresolver.hh"
 
 #ifndef MOZART_GENERATOR
 
@@ -123,6 +126,13 @@ BoostEnvironment::BoostEnvironment(const VMStarter& vmStarter) :
 #endif
 }
 
+BoostEnvironment::~BoostEnvironment() {
+  // Operations still pending belong to VMs that are gone anyway
+  _fileIOWork.reset();
+  _fileIOService.stop();
+  _fileIOThreads.join_all();
+}
+
 VMIdentifier BoostEnvironment::addVM(VMIdentifier parent,
                                      std::unique_ptr<std::string>&& app, bool isURL,
                                      VirtualMachineOptions options) {
@@ -203,6 +213,19 @@ int BoostEnvironment::runIO() {
   return _exitCode;
 }
 
+void BoostEnvironment::postFileIOTask(std::function<void()> task) {
+  {
+    boost::lock_guard<boost::mutex> lock(_fileIOMutex);
+    if (_fileIOWork == nullptr) {
+      _fileIOWork.reset(new boost::asio::io_service::work(_fileIOService));
+      for (unsigned int i = 0; i < FileIOThreadCount; i++)
+        _fileIOThreads.create_thread([this] () { _fileIOService.run(); });
+    }
+  }
+
+  _fileIOService.post(task);
+}
+
 void BoostEnvironment::withSecondMemoryManager(const std::function<void(MemoryManager&)>& doGC) {
   // Disallow concurrent GCs, so only one has access to the second MemoryManager
   // at a time and we have a much lower maximal memory footprint.
@@ -0,0 +1,112 @@
+// Copyright © 2014, Université catholique de Louvain
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// *  Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// *  Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef MOZART_BOOSTENVFILEIO_DECL_H
+#define MOZART_BOOSTENVFILEIO_DECL_H
+
+#include <mozart.hh>
+
+#include <cstdio>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <boost/system/error_code.hpp>
+
+#ifdef MOZART_WINDOWS
+#  include <windows.h>
+#endif
+
+namespace mozart { namespace boostenv {
+
+/////////////////
+// AsyncFileIO //
+/////////////////
+
+/**
+ * Positional reads and writes run on the file I/O thread pool
+ * Each operation works on its own duplicate of the file handle, so that the
+ * file can be closed while the operation is in progress. Operations bypass
+ * the stdio buffer. On POSIX systems, they do not move the position of the
+ * file. On Windows, a duplicated handle shares the position of the original
+ * one, and ReadFile/WriteFile move it even at an explicit offset, so the
+ * position of the stdio stream is undefined after an operation; seek before
+ * using the stream again.
+ */
+class AsyncFileIO {
+public:
+#ifdef MOZART_WINDOWS
+  typedef HANDLE NativeHandle;
+#else
+  typedef int NativeHandle;
+#endif
+
+  typedef std::vector<unsigned char> Buffer;
+
+public:
+  inline
+  static boost::system::error_code duplicate(std::FILE* file,
+                                             NativeHandle& result);
+
+  /**
+   * Read up to `count` bytes at `offset`, then bind the node to a ByteString
+   * Takes ownership of the handle.
+   */
+  inline
+  static void startRead(VM vm, NativeHandle handle, std::uint64_t offset,
+                        size_t count, const ProtectedNode& resultNode);
+
+  /**
+   * Write `data` at `offset`, then bind the node to the written count
+   * Takes ownership of the handle.
+   */
+  inline
+  static void startWrite(VM vm, NativeHandle handle, std::uint64_t offset,
+                         const std::shared_ptr<Buffer>& data,
+                         const ProtectedNode& resultNode);
+
+private:
+  // Never transfer more than this in one system call
+  static const size_t MaxChunkSize = 16 * 1024 * 1024;
+
+  inline
+  static boost::system::error_code lastError();
+
+  inline
+  static void close(NativeHandle handle);
+
+  inline
+  static boost::system::error_code readAt(
+    NativeHandle handle, std::uint64_t offset, unsigned char* data,
+    size_t count, size_t& transferred);
+
+  inline
+  static boost::system::error_code writeAt(
+    NativeHandle handle, std::uint64_t offset, const unsigned char* data,
+    size_t count, size_t& transferred);
+};
+
+} }
+
+#endif // MOZART_BOOSTENVFILEIO_DECL_H
@@ -0,0 +1,225 @@
+// Copyright © 2014, Université catholique de Louvain
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// *  Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// *  Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef MOZART_BOOSTENVFILEIO_H
+#define MOZART_BOOSTENVFILEIO_H
+
+#include <cerrno>
+#include <cstring>
+#include <new>
+
+#include "boostenvfileio-decl.hh"
+
+#include "boostenv-decl.hh"
+
+#ifdef MOZART_WINDOWS
+#  include <io.h>
+#else
+#  include <unistd.h>
+#endif
+
+#ifndef MOZART_GENERATOR
+
+namespace mozart { namespace boostenv {
+
+/////////////////
+// AsyncFileIO //
+/////////////////
+
+boost::system::error_code AsyncFileIO::duplicate(std::FILE* file,
+                                                 NativeHandle& result) {
+#ifdef MOZART_WINDOWS
+  HANDLE original = (HANDLE) _get_osfhandle(_fileno(file));
+  if (!DuplicateHandle(GetCurrentProcess(), original, GetCurrentProcess(),
+                       &result, 0, FALSE, DUPLICATE_SAME_ACCESS))
+    return lastError();
+#else
+  result = ::dup(fileno(file));
+  if (result < 0)
+    return lastError();
+#endif
+
+  return boost::system::error_code();
+}
+
+void AsyncFileIO::startRead(VM vm, NativeHandle handle, std::uint64_t offset,
+                            size_t count, const ProtectedNode& resultNode) {
+  BoostEnvironment& env = BoostEnvironment::forVM(vm);
+  VMIdentifier identifier = BoostVM::forVM(vm).identifier;
+
+  env.postFileIOTask([=, &env] () {
+    auto data = std::make_shared<Buffer>();
+    size_t transferred = 0;
+    boost::system::error_code error;
+
+    try {
+      data->resize(count);
+      error = readAt(handle, offset, data->data(), count, transferred);
+      data->resize(transferred);
+    } catch (const std::bad_alloc&) {
+      error = boost::system::errc::make_error_code(
+        boost::system::errc::not_enough_memory);
+    }
+    close(handle);
+
+    env.postVMEvent(identifier, [=] (BoostVM& boostVM) {
+      if (!error) {
+        VM vm = boostVM.vm;
+        boostVM.bindAndReleaseAsyncIOFeedbackNode(
+          resultNode, ByteString::build(
+            vm, newLString(vm, data->data(), data->size())));
+      } else {
+        boostVM.raiseOSErrorAndReleaseAsyncIOFeedbackNode(
+          resultNode, "pread", error);
+      }
+    });
+  });
+}
+
+void AsyncFileIO::startWrite(VM vm, NativeHandle handle, std::uint64_t offset,
+                             const std::shared_ptr<Buffer>& data,
+                             const ProtectedNode& resultNode) {
+  BoostEnvironment& env = BoostEnvironment::forVM(vm);
+  VMIdentifier identifier = BoostVM::forVM(vm).identifier;
+
+  env.postFileIOTask([=, &env] () {
+    size_t transferred = 0;
+    auto error = writeAt(handle, offset, data->data(), data->size(),
+                         transferred);
+    close(handle);
+
+    env.postVMEvent(identifier, [=] (BoostVM& boostVM) {
+      if (!error) {
+        boostVM.bindAndReleaseAsyncIOFeedbackNode(resultNode, transferred);
+      } else {
+        boostVM.raiseOSErrorAndReleaseAsyncIOFeedbackNode(
+          resultNode, "pwrite", error);
+      }
+    });
+  });
+}
+
+boost::system::error_code AsyncFileIO::lastError() {
+#ifdef MOZART_WINDOWS
+  return boost::system::error_code(GetLastError(),
+                                   boost::system::system_category());
+#else
+  return boost::system::error_code(errno, boost::system::system_category());
+#endif
+}
+
+void AsyncFileIO::close(NativeHandle handle) {
+#ifdef MOZART_WINDOWS
+  CloseHandle(handle);
+#else
+  ::close(handle);
+#endif
+}
+
+boost::system::error_code AsyncFileIO::readAt(
+  NativeHandle handle, std::uint64_t offset, unsigned char* data,
+  size_t count, size_t& transferred) {
+
+  transferred = 0;
+  while (transferred < count) {
+    size_t chunkSize = count - transferred;
+    if (chunkSize > MaxChunkSize)
+      chunkSize = MaxChunkSize;
+    std::uint64_t position = offset + transferred;
+
+#ifdef MOZART_WINDOWS
+    OVERLAPPED overlapped;
+    std::memset(&overlapped, 0, sizeof(overlapped));
+    overlapped.Offset = (DWORD) position;
+    overlapped.OffsetHigh = (DWORD) (position >> 32);
+
+    DWORD done = 0;
+    if (!ReadFile(handle, data + transferred, (DWORD) chunkSize, &done,
+                  &overlapped)) {
+      if (GetLastError() == ERROR_HANDLE_EOF)
+        break;
+      return lastError();
+    }
+#else
+    ssize_t done = ::pread(handle, data + transferred, chunkSize,
+                           (off_t) position);
+    if (done < 0) {
+      if (errno == EINTR)
+        continue;
+      return lastError();
+    }
+#endif
+
+    if (done == 0) // end of file
+      break;
+    transferred += done;
+  }
+
+  return boost::system::error_code();
+}
+
+boost::system::error_code AsyncFileIO::writeAt(
+  NativeHandle handle, std::uint64_t offset, const unsigned char* data,
+  size_t count, size_t& transferred) {
+
+  transferred = 0;
+  while (transferred < count) {
+    size_t chunkSize = count - transferred;
+    if (chunkSize > MaxChunkSize)
+      chunkSize = MaxChunkSize;
+    std::uint64_t position = offset + transferred;
+
+#ifdef MOZART_WINDOWS
+    OVERLAPPED overlapped;
+    std::memset(&overlapped, 0, sizeof(overlapped));
+    overlapped.Offset = (DWORD) position;
+    overlapped.OffsetHigh = (DWORD) (position >> 32);
+
+    DWORD done = 0;
+    if (!WriteFile(handle, data + transferred, (DWORD) chunkSize, &done,
+                   &overlapped))
+      return lastError();
+#else
+    ssize_t done = ::pwrite(handle, data + transferred, chunkSize,
+                            (off_t) position);
+    if (done < 0) {
+      if (errno == EINTR)
+        continue;
+      return lastError();
+    }
+#endif
+
+    if (done == 0)
+      break;
+    transferred += done;
+  }
+
+  return boost::system::error_code();
+}
+
+} }
+
+#endif
+
+#endif // MOZART_BOOSTENVFILEIO_H
@@ -29,6 +29,7 @@
 #include "boostenv.hh"
 
 #include "modos.hh"
+#include "modsharedtable.hh"
 #include "modvm.hh"
 
 #endif // MOZART_BOOSTENVMODULES_H
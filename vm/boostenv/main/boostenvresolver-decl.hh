@@ -0,0 +1,114 @@
+// Copyright © 2014, Université catholique de Louvain
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// *  Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// *  Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef MOZART_BOOSTENVRESOLVER_DECL_H
+#define MOZART_BOOSTENVRESOLVER_DECL_H
+
+#include <mozart.hh>
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/thread.hpp>
+
+namespace mozart { namespace boostenv {
+
+//////////////////
+// HostResolver //
+//////////////////
+
+/**
+ * Host name resolution that does not block the VM, with a cache shared by
+ * all the VMs of the environment
+ * Resolved addresses stay in the cache for its time to live. A time to live
+ * of 0, the default, disables the cache.
+ */
+class HostResolver {
+public:
+  typedef std::vector<std::string> Addresses;
+
+  HostResolver(): _timeToLive(0), _cacheHits(0) {}
+
+  HostResolver(const HostResolver&) = delete;
+
+public:
+  std::int64_t getTimeToLive() {
+    boost::lock_guard<boost::mutex> lock(_mutex);
+    return _timeToLive;
+  }
+
+  /** Set the time to live in milliseconds, which also empties the cache */
+  void setTimeToLive(std::int64_t milliseconds) {
+    boost::lock_guard<boost::mutex> lock(_mutex);
+    _timeToLive = milliseconds;
+    _entries.clear();
+  }
+
+  /** Number of lookups answered by the cache so far */
+  std::int64_t getCacheHits() {
+    boost::lock_guard<boost::mutex> lock(_mutex);
+    return _cacheHits;
+  }
+
+  /** Addresses of a host resolved less than the time to live ago, if any */
+  inline
+  bool lookup(const std::string& name, Addresses& addresses);
+
+  inline
+  void store(const std::string& name, const Addresses& addresses);
+
+  /**
+   * Resolve a host name on the I/O service, then bind the node to a
+   * hostent(addrList:_ aliases:_ name:_) record whose name is nameNode
+   */
+  inline
+  void startAsyncResolve(VM vm, const std::string& name,
+                         const ProtectedNode& nameNode,
+                         const ProtectedNode& resultNode);
+
+  template <typename N>
+  inline
+  static UnstableNode buildHostEntry(VM vm, N&& name,
+                                     const Addresses& addresses);
+
+private:
+  // Beyond that, entries are dropped rather than kept growing
+  static const size_t MaxEntries = 1024;
+
+  struct Entry {
+    std::int64_t expiry;
+    Addresses addresses;
+  };
+
+  boost::mutex _mutex;
+  std::int64_t _timeToLive;
+  std::int64_t _cacheHits;
+  std::unordered_map<std::string, Entry> _entries;
+};
+
+} }
+
+#endif // MOZART_BOOSTENVRESOLVER_DECL_H
@@ -0,0 +1,137 @@
+// Copyright © 2014, Université catholique de Louvain
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// *  Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// *  Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef MOZART_BOOSTENVRESOLVER_H
+#define MOZART_BOOSTENVRESOLVER_H
+
+#include <memory>
+
+#include "boostenvresolver-decl.hh"
+
+#include "boostenv-decl.hh"
+
+#ifndef MOZART_GENERATOR
+
+namespace mozart { namespace boostenv {
+
+//////////////////
+// HostResolver //
+//////////////////
+
+bool HostResolver::lookup(const std::string& name, Addresses& addresses) {
+  boost::lock_guard<boost::mutex> lock(_mutex);
+  if (_timeToLive <= 0)
+    return false;
+
+  auto iter = _entries.find(name);
+  if (iter == _entries.end())
+    return false;
+
+  if (iter->second.expiry <= BoostEnvironment::getReferenceTime()) {
+    _entries.erase(iter);
+    return false;
+  }
+
+  addresses = iter->second.addresses;
+  _cacheHits++;
+  return true;
+}
+
+void HostResolver::store(const std::string& name,
+                         const Addresses& addresses) {
+  boost::lock_guard<boost::mutex> lock(_mutex);
+  if (_timeToLive <= 0)
+    return;
+
+  std::int64_t now = BoostEnvironment::getReferenceTime();
+
+  if (_entries.size() >= MaxEntries) {
+    for (auto iter = _entries.begin(); iter != _entries.end(); ) {
+      if (iter->second.expiry <= now)
+        iter = _entries.erase(iter);
+      else
+        ++iter;
+    }
+    if (_entries.size() >= MaxEntries)
+      _entries.clear();
+  }
+
+  _entries[name] = { now + _timeToLive, addresses };
+}
+
+void HostResolver::startAsyncResolve(VM vm, const std::string& name,
+                                     const ProtectedNode& nameNode,
+                                     const ProtectedNode& resultNode) {
+  typedef boost::asio::ip::tcp tcp;
+
+  BoostEnvironment& env = BoostEnvironment::forVM(vm);
+  VMIdentifier identifier = BoostVM::forVM(vm).identifier;
+
+  // The handler keeps the resolver alive until the resolution is done
+  auto resolver = std::make_shared<tcp::resolver>(env.io_service);
+
+  auto handler = [this, &env, identifier, name, nameNode, resultNode,
+                  resolver] (
+    const boost::system::error_code& error,
+    tcp::resolver::iterator endpoints) {
+
+    Addresses addresses;
+    if (!error) {
+      for (tcp::resolver::iterator end; endpoints != end; ++endpoints)
+        addresses.push_back(endpoints->endpoint().address().to_string());
+      store(name, addresses);
+    }
+
+    env.postVMEvent(identifier, [=] (BoostVM& boostVM) {
+      if (!error) {
+        VM vm = boostVM.vm;
+        boostVM.bindAndReleaseAsyncIOFeedbackNode(
+          resultNode, buildHostEntry(vm, *nameNode, addresses));
+      } else {
+        boostVM.raiseOSErrorAndReleaseAsyncIOFeedbackNode(
+          resultNode, "getHostByName", error);
+      }
+    });
+  };
+
+  resolver->async_resolve(tcp::resolver::query(name, "0"), handler);
+}
+
+template <typename N>
+UnstableNode HostResolver::buildHostEntry(VM vm, N&& name,
+                                          const Addresses& addresses) {
+  OzListBuilder addrListBuilder(vm);
+  for (auto& address : addresses)
+    addrListBuilder.push_back(vm, String::build(vm, newLString(vm, address)));
+
+  auto arity = buildArity(vm, "hostent", "addrList", "aliases", "name");
+  return buildRecord(vm, std::move(arity), addrListBuilder.get(vm),
+                     vm->coreatoms.nil, std::forward<N>(name));
+}
+
+} }
+
+#endif
+
+#endif // MOZART_BOOSTENVRESOLVER_H
@@ -0,0 +1,181 @@
+// Copyright © 2014, Université catholique de Louvain
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// *  Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// *  Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef MOZART_BOOSTENVSHAREDTABLE_DECL_H
+#define MOZART_BOOSTENVSHAREDTABLE_DECL_H
+
+#include <mozart.hh>
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <boost/thread.hpp>
+
+namespace mozart { namespace boostenv {
+
+/////////////////
+// SharedTable //
+/////////////////
+
+/**
+ * Concurrent hash table shared by all the VMs of a BoostEnvironment
+ * Keys are encoded as strings so that they do not depend on the atom table of
+ * any VM. Values live outside of the VM heaps: integers that fit in a
+ * nativeint are stored as counters, anything else as a pickle, which a VM
+ * unpickles into its own heap only when it reads the value.
+ * Entries are spread over stripes, each guarded by its own reader-writer
+ * lock, so that readers never exclude each other and a writer only blocks
+ * the readers of its own stripe. Counters are updated with atomic operations
+ * under a read lock.
+ */
+class SharedTable {
+public:
+  typedef std::string Key;
+
+  struct Value {
+    Value(): counter(0) {}
+
+    explicit Value(nativeint counter): counter(counter) {}
+
+    explicit Value(std::shared_ptr<const std::string> pickle):
+      pickle(std::move(pickle)), counter(0) {}
+
+    bool isCounter() const {
+      return pickle == nullptr;
+    }
+
+    std::shared_ptr<const std::string> pickle; // nullptr for a counter
+    nativeint counter;
+  };
+
+  enum class CounterResult {
+    updated, notFound, notACounter, overflow
+  };
+
+  static const size_t StripeCount = 16;
+
+public:
+  SharedTable(): _deleted(false) {}
+
+  SharedTable(const SharedTable&) = delete;
+  SharedTable& operator=(const SharedTable&) = delete;
+
+public:
+  inline
+  bool get(const Key& key, Value& value);
+
+  inline
+  bool member(const Key& key);
+
+  inline
+  void put(const Key& key, const Value& value);
+
+  inline
+  bool remove(const Key& key);
+
+  /** Atomically adds increment to a counter and returns its new value */
+  inline
+  CounterResult updateCounter(const Key& key, nativeint increment,
+                              nativeint& result);
+
+  inline
+  size_t size();
+
+  /**
+   * Copy of the entries, taken one stripe at a time
+   * Pickles are shared with the table, not copied.
+   */
+  inline
+  std::vector<std::pair<Key, Value>> snapshot();
+
+  inline
+  void clear();
+
+public:
+  bool isDeleted() {
+    return _deleted;
+  }
+
+  void markDeleted() {
+    _deleted = true;
+  }
+
+private:
+  struct Entry {
+    Entry(): counter(0) {}
+
+    std::shared_ptr<const std::string> pickle;
+    std::atomic<nativeint> counter;
+  };
+
+  struct Stripe {
+    boost::shared_mutex mutex;
+    std::unordered_map<Key, Entry> entries;
+  };
+
+  inline
+  Stripe& stripeFor(const Key& key);
+
+private:
+  Stripe _stripes[StripeCount];
+  std::atomic_bool _deleted;
+};
+
+/////////////////////////
+// SharedTableRegistry //
+/////////////////////////
+
+/**
+ * Named shared tables of a BoostEnvironment
+ * VMs look up tables rarely, as they keep the tables they use in a cache
+ * which they revalidate with SharedTable::isDeleted().
+ */
+class SharedTableRegistry {
+public:
+  /** Returns the table with the given name, creating it if needed */
+  inline
+  std::shared_ptr<SharedTable> open(const std::string& name);
+
+  /** Returns the table with the given name, or nullptr */
+  inline
+  std::shared_ptr<SharedTable> find(const std::string& name);
+
+  inline
+  bool remove(const std::string& name);
+
+  inline
+  std::vector<std::string> names();
+
+private:
+  std::unordered_map<std::string, std::shared_ptr<SharedTable>> _tables;
+  boost::mutex _mutex;
+};
+
+} }
+
+#endif // MOZART_BOOSTENVSHAREDTABLE_DECL_H
@@ -0,0 +1,194 @@
+// Copyright © 2014, Université catholique de Louvain
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// *  Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// *  Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef MOZART_BOOSTENVSHAREDTABLE_H
+#define MOZART_BOOSTENVSHAREDTABLE_H
+
+#include "boostenvsharedtable-decl.hh"
+
+#include <functional>
+#include <limits>
+
+#ifndef MOZART_GENERATOR
+
+namespace mozart { namespace boostenv {
+
+/////////////////
+// SharedTable //
+/////////////////
+
+SharedTable::Stripe& SharedTable::stripeFor(const Key& key) {
+  return _stripes[std::hash<Key>()(key) % StripeCount];
+}
+
+bool SharedTable::get(const Key& key, Value& value) {
+  Stripe& stripe = stripeFor(key);
+  boost::shared_lock<boost::shared_mutex> lock(stripe.mutex);
+
+  auto iter = stripe.entries.find(key);
+  if (iter == stripe.entries.end())
+    return false;
+
+  value.pickle = iter->second.pickle;
+  value.counter = iter->second.counter.load();
+  return true;
+}
+
+bool SharedTable::member(const Key& key) {
+  Stripe& stripe = stripeFor(key);
+  boost::shared_lock<boost::shared_mutex> lock(stripe.mutex);
+  return stripe.entries.count(key) != 0;
+}
+
+void SharedTable::put(const Key& key, const Value& value) {
+  Stripe& stripe = stripeFor(key);
+  boost::unique_lock<boost::shared_mutex> lock(stripe.mutex);
+
+  Entry& entry = stripe.entries[key];
+  entry.pickle = value.pickle;
+  entry.counter.store(value.counter);
+}
+
+bool SharedTable::remove(const Key& key) {
+  Stripe& stripe = stripeFor(key);
+  boost::unique_lock<boost::shared_mutex> lock(stripe.mutex);
+  return stripe.entries.erase(key) != 0;
+}
+
+SharedTable::CounterResult SharedTable::updateCounter(
+  const Key& key, nativeint increment, nativeint& result) {
+
+  Stripe& stripe = stripeFor(key);
+  // Writers of this stripe are excluded, so the entry cannot go away nor
+  // stop being a counter; concurrent updates race on the atomic only
+  boost::shared_lock<boost::shared_mutex> lock(stripe.mutex);
+
+  auto iter = stripe.entries.find(key);
+  if (iter == stripe.entries.end())
+    return CounterResult::notFound;
+
+  Entry& entry = iter->second;
+  if (entry.pickle != nullptr)
+    return CounterResult::notACounter;
+
+  nativeint current = entry.counter.load();
+  do {
+    if ((increment > 0 &&
+         current > std::numeric_limits<nativeint>::max() - increment) ||
+        (increment < 0 &&
+         current < std::numeric_limits<nativeint>::min() - increment))
+      return CounterResult::overflow;
+    result = current + increment;
+  } while (!entry.counter.compare_exchange_weak(current, result));
+
+  return CounterResult::updated;
+}
+
+size_t SharedTable::size() {
+  size_t result = 0;
+  for (auto& stripe : _stripes) {
+    boost::shared_lock<boost::shared_mutex> lock(stripe.mutex);
+    result += stripe.entries.size();
+  }
+  return result;
+}
+
+std::vector<std::pair<SharedTable::Key, SharedTable::Value>>
+SharedTable::snapshot() {
+  std::vector<std::pair<Key, Value>> result;
+  for (auto& stripe : _stripes) {
+    boost::shared_lock<boost::shared_mutex> lock(stripe.mutex);
+    for (auto& entry : stripe.entries) {
+      Value value;
+      value.pickle = entry.second.pickle;
+      value.counter = entry.second.counter.load();
+      result.emplace_back(entry.first, std::move(value));
+    }
+  }
+  return result;
+}
+
+void SharedTable::clear() {
+  for (auto& stripe : _stripes) {
+    boost::unique_lock<boost::shared_mutex> lock(stripe.mutex);
+    stripe.entries.clear();
+  }
+}
+
+/////////////////////////
+// SharedTableRegistry //
+/////////////////////////
+
+std::shared_ptr<SharedTable> SharedTableRegistry::open(
+  const std::string& name) {
+
+  boost::lock_guard<boost::mutex> lock(_mutex);
+  auto& table = _tables[name];
+  if (table == nullptr)
+    table = std::make_shared<SharedTable>();
+  return table;
+}
+
+std::shared_ptr<SharedTable> SharedTableRegistry::find(
+  const std::string& name) {
+
+  boost::lock_guard<boost::mutex> lock(_mutex);
+  auto iter = _tables.find(name);
+  if (iter == _tables.end())
+    return nullptr;
+  return iter->second;
+}
+
+bool SharedTableRegistry::remove(const std::string& name) {
+  std::shared_ptr<SharedTable> table;
+  {
+    boost::lock_guard<boost::mutex> lock(_mutex);
+    auto iter = _tables.find(name);
+    if (iter == _tables.end())
+      return false;
+    table = std::move(iter->second);
+    _tables.erase(iter);
+  }
+
+  // VMs still holding the table in their cache see it is gone, and the
+  // memory of the entries is released now rather than when the last of
+  // them drops its reference
+  table->markDeleted();
+  table->clear();
+  return true;
+}
+
+std::vector<std::string> SharedTableRegistry::names() {
+  boost::lock_guard<boost::mutex> lock(_mutex);
+  std::vector<std::string> result;
+  for (auto& table : _tables)
+    result.push_back(table.first);
+  return result;
+}
+
+} }
+
+#endif // MOZART_GENERATOR
+
+#endif // MOZART_BOOSTENVSHAREDTABLE_H
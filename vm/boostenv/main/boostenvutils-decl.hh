@@ -28,6 +28,7 @@
 #include <mozart.hh>
 
 #include <memory>
+#include <streambuf>
 
 #include <boost/asio.hpp>
 #include <boost/date_time/posix_time/posix_time.hpp>
@@ -97,6 +98,21 @@ protected:
   std::vector<char> _writeData;
 };
 
+/////////////////////
+// MemoryStreamBuf //
+/////////////////////
+
+/**
+ * Read-only stream buffer over a memory region, to unpickle in place
+ */
+class MemoryStreamBuf: public std::streambuf {
+public:
+  MemoryStreamBuf(const char* data, size_t size) {
+    char* begin = const_cast<char*>(data);
+    setg(begin, begin, begin + size);
+  }
+};
+
 } }
 
 #endif // MOZART_BOOSTENVUTILS_DECL_H
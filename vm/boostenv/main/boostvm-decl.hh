@@ -36,6 +36,8 @@
 
 #include <boost/asio.hpp>
 
+#include "boostenvsharedtable-decl.hh"
+
 namespace mozart { namespace boostenv {
 
 class BoostEnvironment;
@@ -84,6 +86,21 @@ public:
 
   void receiveOnVMStream(std::string* buffer);
 
+// VM channels: private streams of a VM that other VMs can send to
+public:
+  /**
+   * Create a channel of this VM and return its number
+   * The VM waits for messages on the channel until closeChannel().
+   */
+  nativeint newChannel(UnstableNode& stream);
+
+  void closeChannel(nativeint channel);
+
+  void sendOnVMChannel(VMIdentifier to, nativeint channel, RichNode value);
+
+private:
+  void receiveOnVMChannel(nativeint channel, std::string* buffer);
+
 // Termination
 public:
   void requestTermination(nativeint exitCode,
@@ -120,12 +137,24 @@ public:
   void raiseAndReleaseAsyncIOFeedbackNode(const ProtectedNode& ref,
                                           LT&& label, Args&&... args);
 
+  /** Fail the node with the same exception as raiseOSError() */
+  inline
+  void raiseOSErrorAndReleaseAsyncIOFeedbackNode(
+    const ProtectedNode& ref, const char* function,
+    const boost::system::error_code& error);
+
 // Notification from asynchronous work
 private:
   friend class BoostEnvironment;
   inline
   void postVMEvent(std::function<void(BoostVM&)> callback);
 
+// Shared tables
+public:
+  /** Returns the shared table with the given name, or nullptr */
+  inline
+  std::shared_ptr<SharedTable> findSharedTable(const std::string& name);
+
 // GC
 public:
   void gCollect(GC gc) {
@@ -170,6 +199,11 @@ private:
 private:
   std::queue<std::function<void(BoostVM&)> > _vmEventsCallbacks;
 
+// Open channels, by number
+private:
+  std::unordered_map<nativeint, ProtectedNode> _channels;
+  nativeint _nextChannel;
+
 // Monitors
 private:
   std::vector<VMIdentifier> _monitors;
@@ -180,6 +214,10 @@ private:
   nativeint _terminationStatus;
   std::string _terminationReason;
 
+// Shared tables used by this VM, so that lookups bypass the registry lock
+private:
+  std::unordered_map<std::string, std::shared_ptr<SharedTable>> _sharedTables;
+
 // Running thread management
 private:
   boost::asio::io_service::work* _work;
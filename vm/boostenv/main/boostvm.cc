@@ -44,6 +44,7 @@ BoostVM::BoostVM(BoostEnvironment& environment,
   uuidGenerator(random_generator),
   portClosed(false),
   _asyncIONodeCount(0),
+  _nextChannel(1),
   preemptionTimer(environment.io_service),
   alarmTimer(environment.io_service),
   _terminationRequested(false),
@@ -57,8 +58,14 @@ BoostVM::BoostVM(BoostEnvironment& environment,
     addMonitor(parent);
 
   builtins::biref::registerBuiltinModOS(vm);
+  builtins::biref::registerBuiltinModSharedTable(vm);
   builtins::biref::registerBuiltinModVM(vm);
 
+  getPropertyRegistry().registerReadOnlyProp<nativeint>(vm, "host.cacheHits",
+    [] (VM vm) -> nativeint {
+      return BoostEnvironment::forVM(vm).getHostResolver().getCacheHits();
+    });
+
   // Initialize the pseudo random number generator with a really random seed
   boost::random::random_device generator;
   random_generator.seed(generator);
@@ -264,6 +271,54 @@ void BoostVM::receiveOnVMStream(std::string* buffer) {
   sendToReadOnlyStream(vm, _stream, unpickled);
 }
 
+nativeint BoostVM::newChannel(UnstableNode& stream) {
+  StableNode* tail = new (vm) StableNode(vm, ReadOnlyVariable::build(vm));
+  stream.copy(vm, *tail);
+
+  nativeint channel = _nextChannel++;
+  _channels.emplace(channel, allocAsyncIONode(tail));
+  return channel;
+}
+
+void BoostVM::closeChannel(nativeint channel) {
+  auto iter = _channels.find(channel);
+  if (iter == _channels.end())
+    return;
+
+  UnstableNode nil = buildNil(vm);
+  BindableReadOnly(*iter->second).bindReadOnly(vm, nil);
+  releaseAsyncIONode(iter->second);
+  _channels.erase(iter);
+}
+
+void BoostVM::sendOnVMChannel(VMIdentifier to, nativeint channel,
+                              RichNode value) {
+  std::ostringstream out;
+  pickle(vm, value, out);
+  std::string* buffer = new std::string(out.str());
+
+  bool found = env.postVMEvent(to, [buffer, channel] (BoostVM& targetVM) {
+    targetVM.receiveOnVMChannel(channel, buffer);
+  });
+  if (!found)
+    delete buffer;
+}
+
+void BoostVM::receiveOnVMChannel(nativeint channel, std::string* buffer) {
+  auto iter = _channels.find(channel);
+  if (iter == _channels.end()) {
+    delete buffer;
+    return;
+  }
+
+  std::istringstream input(*buffer);
+  UnstableNode unpickled = unpickle(vm, input);
+  delete buffer;
+
+  std::shared_ptr<StableNode*> tail = iter->second;
+  sendToReadOnlyStream(vm, *tail, unpickled);
+}
+
 void BoostVM::requestTermination(nativeint exitCode, const std::string& reason) {
   _terminationStatus = exitCode;
   _terminationReason = reason;
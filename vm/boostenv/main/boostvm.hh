@@ -74,6 +74,19 @@ void BoostVM::raiseAndReleaseAsyncIOFeedbackNode(
     ref, FailedValue::build(vm, RichNode(exception).getStableRef(vm)));
 }
 
+void BoostVM::raiseOSErrorAndReleaseAsyncIOFeedbackNode(
+  const ProtectedNode& ref, const char* function,
+  const boost::system::error_code& error) {
+
+  UnstableNode exception = buildRecord(
+    vm, buildArity(vm, vm->coreatoms.system, 1, vm->coreatoms.debug),
+    buildTuple(vm, "os", "os", function, (nativeint) error.value(),
+               vm->getAtom(error.message())),
+    unit);
+  bindAndReleaseAsyncIOFeedbackNode(
+    ref, FailedValue::build(vm, RichNode(exception).getStableRef(vm)));
+}
+
 void BoostVM::postVMEvent(std::function<void(BoostVM&)> callback) {
   {
     boost::unique_lock<boost::mutex> lock(_conditionWorkToDoInVMMutex);
@@ -84,6 +97,20 @@ void BoostVM::postVMEvent(std::function<void(BoostVM&)> callback) {
   _conditionWorkToDoInVM.notify_all();
 }
 
+std::shared_ptr<SharedTable> BoostVM::findSharedTable(const std::string& name) {
+  auto iter = _sharedTables.find(name);
+  if (iter != _sharedTables.end()) {
+    if (!iter->second->isDeleted())
+      return iter->second;
+    _sharedTables.erase(iter);
+  }
+
+  auto table = env.getSharedTables().find(name);
+  if (table != nullptr)
+    _sharedTables[name] = table;
+  return table;
+}
+
 } }
 
 #endif
@@ -30,6 +30,8 @@
 #include "boostenv-decl.hh"
 #include "boostenvtcp-decl.hh"
 #include "boostenvpipe-decl.hh"
+#include "boostenvfileio-decl.hh"
+#include "boostenvresolver-decl.hh"
 
 #include <iostream>
 
@@ -220,6 +222,13 @@ private:
     return wrappedFile;
   }
 
+  static nativeint getNonNegativeArgument(VM vm, RichNode arg) {
+    auto value = getArgument<nativeint>(vm, arg);
+    if (value < 0)
+      raiseTypeError(vm, "non-negative Integer", arg);
+    return value;
+  }
+
 public:
   class GetDir: public Builtin<GetDir> {
   public:
@@ -421,6 +430,109 @@ public:
     }
   };
 
+  /**
+   * Read up to Count bytes at Offset on the file I/O thread pool
+   * Result is bound to a ByteString, shorter than Count at the end of the
+   * file. Neither the stdio buffer nor the position of the file are used, but
+   * on Windows the position is moved (see AsyncFileIO).
+   */
+  class AsyncRead: public Builtin<AsyncRead> {
+  public:
+    AsyncRead(): Builtin("asyncRead") {}
+
+    static void call(VM vm, In fileNode, In offset, In count, Out result) {
+      auto file = getFileArgument(vm, fileNode)->file();
+      auto intOffset = getNonNegativeArgument(vm, offset);
+      auto intCount = getNonNegativeArgument(vm, count);
+
+      AsyncFileIO::NativeHandle handle;
+      auto error = AsyncFileIO::duplicate(file, handle);
+      if (error)
+        raiseOSError(vm, "dup", error);
+
+      auto resultNode = BoostVM::forVM(vm).createAsyncIOFeedbackNode(result);
+      AsyncFileIO::startRead(vm, handle, intOffset, intCount, resultNode);
+    }
+  };
+
+  /**
+   * Write Data at Offset on the file I/O thread pool
+   * Result is bound to the number of bytes written. As for asyncRead, the
+   * position of the file is moved on Windows only.
+   */
+  class AsyncWrite: public Builtin<AsyncWrite> {
+  public:
+    AsyncWrite(): Builtin("asyncWrite") {}
+
+    static void call(VM vm, In fileNode, In offset, In data, Out result) {
+      auto file = getFileArgument(vm, fileNode)->file();
+      auto intOffset = getNonNegativeArgument(vm, offset);
+      size_t bufSize = ozVBSLengthForBuffer(vm, data);
+
+      AsyncFileIO::NativeHandle handle;
+      auto error = AsyncFileIO::duplicate(file, handle);
+      if (error)
+        raiseOSError(vm, "dup", error);
+
+      {
+        auto buffer = std::make_shared<AsyncFileIO::Buffer>();
+        ozVBSGet(vm, data, bufSize, *buffer);
+
+        auto resultNode =
+          BoostVM::forVM(vm).createAsyncIOFeedbackNode(result);
+        AsyncFileIO::startWrite(vm, handle, intOffset, buffer, resultNode);
+      }
+    }
+  };
+
+  /**
+   * 64-bit FNV-1a hash of the contents of a file, as 16 hexadecimal digits
+   * It is meant to detect that a file changed, not to resist attacks.
+   */
+  class FileDigest: public Builtin<FileDigest> {
+  public:
+    FileDigest(): Builtin("fileDigest") {}
+
+    static void call(VM vm, In fileName, Out result) {
+      size_t fileNameBufSize = ozVSLengthForBuffer(vm, fileName);
+
+      std::FILE* file;
+      {
+        std::string strFileName;
+        ozVSGet(vm, fileName, fileNameBufSize, strFileName);
+
+        boost::filesystem::path filePath(strFileName);
+        file = std::fopen(filePath.make_preferred().string().c_str(), "rb");
+      }
+
+      if (file == nullptr)
+        raiseLastOSError(vm, "fopen");
+
+      std::uint64_t hash = 14695981039346656037ULL;
+      {
+        std::vector<unsigned char> buffer(64*1024);
+        size_t readCount;
+        while ((readCount = std::fread(buffer.data(), 1, buffer.size(),
+                                       file)) > 0) {
+          for (size_t i = 0; i < readCount; i++) {
+            hash ^= buffer[i];
+            hash *= 1099511628211ULL;
+          }
+        }
+      }
+
+      int errnum = std::ferror(file) ? errno : 0;
+      std::fclose(file);
+      if (errnum != 0)
+        raiseOSError(vm, "fread", errnum);
+
+      char digest[17];
+      std::snprintf(digest, sizeof(digest), "%016llx",
+                    (unsigned long long) hash);
+      result = build(vm, vm->getAtom(digest));
+    }
+  };
+
   class Stdin: public Builtin<Stdin> {
   public:
     Stdin(): Builtin("stdin") {}
@@ -1213,24 +1325,25 @@ public:
         ozVSGet(vm, name, nameBufLength, nameString);
 
         auto& environment = BoostEnvironment::forVM(vm);
-        tcp::resolver resolver (environment.io_service);
-        tcp::resolver::query query (nameString, "0");
-        auto it = resolver.resolve(query, ec);
-        if (!ec) {
-          OzListBuilder addrListBuilder (vm);
-
-          decltype(it) end;
-          while (it != end) {
-            auto addr = it->endpoint().address().to_string();
-            auto addrString = String::build(vm, newLString(vm, addr));
-            addrListBuilder.push_back(vm, addrString);
-            ++ it;
+        auto& hostResolver = environment.getHostResolver();
+
+        HostResolver::Addresses addresses;
+        if (!hostResolver.lookup(nameString, addresses)) {
+          tcp::resolver resolver (environment.io_service);
+          tcp::resolver::query query (nameString, "0");
+          auto it = resolver.resolve(query, ec);
+          if (!ec) {
+            decltype(it) end;
+            while (it != end) {
+              addresses.push_back(it->endpoint().address().to_string());
+              ++ it;
+            }
+            hostResolver.store(nameString, addresses);
           }
+        }
 
-          auto arity = buildArity(vm, "hostent", "addrList", "aliases", "name");
-          res = buildRecord(vm, std::move(arity), addrListBuilder.get(vm),
-                                                  vm->coreatoms.nil,
-                                                  name);
+        if (!ec) {
+          res = HostResolver::buildHostEntry(vm, name, addresses);
           return;
         }
       }
@@ -1239,6 +1352,51 @@ public:
     }
   };
 
+  /**
+   * Like getHostByName, but the resolution does not block the VM
+   * Result is bound to the hostent record when the resolution is done.
+   */
+  class AsyncGetHostByName: public Builtin<AsyncGetHostByName> {
+  public:
+    AsyncGetHostByName(): Builtin("asyncGetHostByName") {}
+
+    static void call(VM vm, In name, Out result) {
+      size_t nameBufLength = ozVSLengthForBuffer(vm, name);
+
+      {
+        std::string nameString;
+        ozVSGet(vm, name, nameBufLength, nameString);
+
+        auto& hostResolver = BoostEnvironment::forVM(vm).getHostResolver();
+
+        HostResolver::Addresses addresses;
+        if (hostResolver.lookup(nameString, addresses)) {
+          result = HostResolver::buildHostEntry(vm, name, addresses);
+          return;
+        }
+
+        auto nameNode = vm->protect(name);
+        auto resultNode = BoostVM::forVM(vm).createAsyncIOFeedbackNode(result);
+        hostResolver.startAsyncResolve(vm, nameString, nameNode, resultNode);
+      }
+    }
+  };
+
+  /**
+   * Time to live, in milliseconds, of the addresses cached by getHostByName
+   * and asyncGetHostByName for all the VMs. 0 disables the cache.
+   */
+  class SetHostCacheTTL: public Builtin<SetHostCacheTTL> {
+  public:
+    SetHostCacheTTL(): Builtin("setHostCacheTTL") {}
+
+    static void call(VM vm, In milliseconds) {
+      auto intMilliseconds = getNonNegativeArgument(vm, milliseconds);
+      BoostEnvironment::forVM(vm).getHostResolver().setTimeToLive(
+        intMilliseconds);
+    }
+  };
+
   class UName: public Builtin<UName> {
     static UnstableNode buildString(VM vm, const char* value) {
       return String::build(vm, newLString(vm, value));
@@ -0,0 +1,273 @@
+// Copyright © 2014, Université catholique de Louvain
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// *  Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// *  Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef MOZART_MODSHAREDTABLE_H
+#define MOZART_MODSHAREDTABLE_H
+
+#include <mozart.hh>
+
+#include <cstring>
+#include <sstream>
+
+#include "boostenv-decl.hh"
+#include "boostenvutils-decl.hh"
+
+#ifndef MOZART_GENERATOR
+
+namespace mozart { namespace boostenv {
+
+namespace builtins {
+
+using namespace ::mozart::builtins;
+
+////////////////////////
+// SharedTable module //
+/////////////////////////
+
+class ModSharedTable: public Module {
+public:
+  ModSharedTable(): Module("SharedTable") {}
+
+  class New: public Builtin<New> {
+  public:
+    New(): Builtin("new") {}
+
+    static void call(VM vm, In name) {
+      auto nameAtom = getArgument<atom_t>(vm, name);
+      BoostEnvironment::forVM(vm).getSharedTables().open(
+        std::string(nameAtom.contents(), nameAtom.length()));
+    }
+  };
+
+  class Delete: public Builtin<Delete> {
+  public:
+    Delete(): Builtin("delete") {}
+
+    static void call(VM vm, In name) {
+      auto nameAtom = getArgument<atom_t>(vm, name);
+      BoostEnvironment::forVM(vm).getSharedTables().remove(
+        std::string(nameAtom.contents(), nameAtom.length()));
+    }
+  };
+
+  class Get: public Builtin<Get> {
+  public:
+    Get(): Builtin("get") {}
+
+    static void call(VM vm, In name, In key, Out result) {
+      auto table = getTable(vm, name);
+      SharedTable::Value value;
+      if (!table->get(encodeKey(vm, key), value))
+        raiseError(vm, "sharedTable", "notFound", name, key);
+      result = materialize(vm, value);
+    }
+  };
+
+  class CondGet: public Builtin<CondGet> {
+  public:
+    CondGet(): Builtin("condGet") {}
+
+    static void call(VM vm, In name, In key, In defaultValue, Out result) {
+      auto table = getTable(vm, name);
+      SharedTable::Value value;
+      if (table->get(encodeKey(vm, key), value))
+        result = materialize(vm, value);
+      else
+        result.copy(vm, defaultValue);
+    }
+  };
+
+  class Put: public Builtin<Put> {
+  public:
+    Put(): Builtin("put") {}
+
+    static void call(VM vm, In name, In key, In value) {
+      if (value.isTransient())
+        waitFor(vm, value);
+
+      auto table = getTable(vm, name);
+
+      if (value.is<SmallInt>()) {
+        auto intValue = value.as<SmallInt>().value();
+        table->put(encodeKey(vm, key), SharedTable::Value(intValue));
+        return;
+      }
+
+      // Wait on nested futures and check for resources before allocating
+      auto noReplacement = buildNil(vm);
+      Pickler pickler(vm);
+      pickler.prepare(value, noReplacement);
+      auto encodedKey = encodeKey(vm, key);
+
+      std::ostringstream out;
+      pickler.write(out);
+      table->put(encodedKey, SharedTable::Value(
+        std::make_shared<const std::string>(out.str())));
+    }
+  };
+
+  class Remove: public Builtin<Remove> {
+  public:
+    Remove(): Builtin("remove") {}
+
+    static void call(VM vm, In name, In key) {
+      getTable(vm, name)->remove(encodeKey(vm, key));
+    }
+  };
+
+  class Member: public Builtin<Member> {
+  public:
+    Member(): Builtin("member") {}
+
+    static void call(VM vm, In name, In key, Out result) {
+      result = build(vm, getTable(vm, name)->member(encodeKey(vm, key)));
+    }
+  };
+
+  class UpdateCounter: public Builtin<UpdateCounter> {
+  public:
+    UpdateCounter(): Builtin("updateCounter") {}
+
+    static void call(VM vm, In name, In key, In increment, Out result) {
+      auto intIncrement = getArgument<nativeint>(vm, increment);
+      auto table = getTable(vm, name);
+
+      nativeint newValue = 0;
+      auto status = table->updateCounter(encodeKey(vm, key), intIncrement,
+                                         newValue);
+
+      switch (status) {
+        case SharedTable::CounterResult::updated:
+          result = build(vm, newValue);
+          break;
+        case SharedTable::CounterResult::notFound:
+          raiseError(vm, "sharedTable", "notFound", name, key);
+        case SharedTable::CounterResult::notACounter:
+          raiseError(vm, "sharedTable", "notACounter", name, key);
+        case SharedTable::CounterResult::overflow:
+          raiseError(vm, "sharedTable", "counterOverflow", name, key);
+      }
+    }
+  };
+
+  class Size: public Builtin<Size> {
+  public:
+    Size(): Builtin("size") {}
+
+    static void call(VM vm, In name, Out result) {
+      result = build(vm, (nativeint) getTable(vm, name)->size());
+    }
+  };
+
+  class Keys: public Builtin<Keys> {
+  public:
+    Keys(): Builtin("keys") {}
+
+    static void call(VM vm, In name, Out result) {
+      OzListBuilder builder(vm);
+      for (auto& entry : getTable(vm, name)->snapshot())
+        builder.push_back(vm, decodeKey(vm, entry.first));
+      result = builder.get(vm);
+    }
+  };
+
+  class Entries: public Builtin<Entries> {
+  public:
+    Entries(): Builtin("entries") {}
+
+    static void call(VM vm, In name, Out result) {
+      OzListBuilder builder(vm);
+      for (auto& entry : getTable(vm, name)->snapshot()) {
+        builder.push_back(vm, buildSharp(vm, decodeKey(vm, entry.first),
+                                         materialize(vm, entry.second)));
+      }
+      result = builder.get(vm);
+    }
+  };
+
+private:
+  /**
+   * The table is kept alive by the cache of the VM, so a raw pointer is
+   * enough for the duration of a builtin, and does not leak a reference
+   * when the builtin raises an exception (see getPointerArgument)
+   */
+  static SharedTable* getTable(VM vm, RichNode name) {
+    auto nameAtom = getArgument<atom_t>(vm, name);
+    SharedTable* table = BoostVM::forVM(vm).findSharedTable(
+      std::string(nameAtom.contents(), nameAtom.length())).get();
+    if (table == nullptr)
+      raiseError(vm, "sharedTable", "unknownTable", name);
+    return table;
+  }
+
+  /**
+   * Keys are atoms or integers, encoded independently of the atom table
+   * Atoms are prefixed with 'a', integers with 'i' followed by their bytes.
+   */
+  static std::string encodeKey(VM vm, RichNode key) {
+    using namespace patternmatching;
+
+    atom_t atomKey;
+    nativeint intKey = 0;
+
+    if (matches(vm, key, capture(atomKey))) {
+      std::string result(1, 'a');
+      result.append(atomKey.contents(), atomKey.length());
+      return result;
+    } else if (matches(vm, key, capture(intKey))) {
+      std::string result(1, 'i');
+      result.append(reinterpret_cast<const char*>(&intKey), sizeof(intKey));
+      return result;
+    } else {
+      raiseTypeError(vm, "Atom or Integer", key);
+    }
+  }
+
+  static UnstableNode decodeKey(VM vm, const std::string& key) {
+    if (key[0] == 'a')
+      return build(vm, vm->getAtom(key.size() - 1, key.data() + 1));
+
+    nativeint intKey;
+    std::memcpy(&intKey, key.data() + 1, sizeof(intKey));
+    return build(vm, intKey);
+  }
+
+  /** Copies a value into the heap of the reading VM */
+  static UnstableNode materialize(VM vm, const SharedTable::Value& value) {
+    if (value.isCounter())
+      return build(vm, value.counter);
+
+    MemoryStreamBuf buffer(value.pickle->data(), value.pickle->size());
+    std::istream input(&buffer);
+    return unpickle(vm, input);
+  }
+};
+
+}
+
+} }
+
+#endif // MOZART_GENERATOR
+
+#endif // MOZART_MODSHAREDTABLE_H
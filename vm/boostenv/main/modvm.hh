@@ -144,6 +144,38 @@ public:
     }
   };
 
+  class NewChannel: public Builtin<NewChannel> {
+  public:
+    NewChannel(): Builtin("newChannel") {}
+
+    static void call(VM vm, Out channel, Out stream) {
+      channel = build(vm, BoostVM::forVM(vm).newChannel(stream));
+    }
+  };
+
+  class SendToChannel: public Builtin<SendToChannel> {
+  public:
+    SendToChannel(): Builtin("sendToChannel") {}
+
+    static void call(VM vm, In vmIdentifier, In channel, In value) {
+      auto& env = BoostEnvironment::forVM(vm);
+      VMIdentifier identifier = env.checkValidIdentifier(vm, vmIdentifier);
+      auto intChannel = getArgument<nativeint>(vm, channel);
+
+      BoostVM::forVM(vm).sendOnVMChannel(identifier, intChannel, value);
+    }
+  };
+
+  class CloseChannel: public Builtin<CloseChannel> {
+  public:
+    CloseChannel(): Builtin("closeChannel") {}
+
+    static void call(VM vm, In channel) {
+      auto intChannel = getArgument<nativeint>(vm, channel);
+      BoostVM::forVM(vm).closeChannel(intChannel);
+    }
+  };
+
   class List: public Builtin<List> {
   public:
     List(): Builtin("list") {}
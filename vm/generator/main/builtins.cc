@@ -50,6 +50,7 @@ struct BuiltinDef {
     nameExpr = nullptr;
     inlineable = false;
     inlineOpCode = 0;
+    autoInline = true;
 
     initFullCppGetter();
   }
@@ -74,6 +75,7 @@ struct BuiltinDef {
 
   bool inlineable;
   size_t inlineOpCode;
+  bool autoInline;
 };
 
 struct ModuleDef {
@@ -171,6 +173,8 @@ void handleBuiltin(BuiltinDef& definition, const ClassDecl* CD) {
     if (markerLabel == "InlineAs") {
       definition.inlineable = true;
       definition.inlineOpCode = getValueParamAsIntegral<size_t>(marker);
+    } else if (markerLabel == "NoAutoInline") {
+      definition.autoInline = false;
     }
   }
 
@@ -294,7 +298,7 @@ void ModuleDef::makeOutput(llvm::raw_fd_ostream& to) {
 }
 
 void BuiltinDef::makeEmulateInlinesOutput(llvm::raw_fd_ostream& to) {
-  if (!inlineable)
+  if (!inlineable || !autoInline)
     return;
 
   to << "\n";
@@ -0,0 +1,133 @@
+#include "benchutils.hh"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+namespace {
+  // Deterministic UUIDs keep runs reproducible
+  class BenchEnvironment: public mozart::VirtualMachineEnvironment {
+  public:
+    BenchEnvironment(): VirtualMachineEnvironment(false), nextUUID(0) {}
+
+    mozart::UUID genUUID(mozart::VM vm) {
+      nextUUID++;
+      return mozart::UUID((nextUUID & ~0xf000) | 0x4000,
+                          ((std::uint64_t) 0x8 << 60) | nextUUID);
+    }
+  private:
+    std::uint64_t nextUUID;
+  };
+
+  struct BenchResult {
+    const char* name;
+    size_t iterations;
+    std::vector<double> nsPerOp;
+  };
+
+  void usage(const char* program) {
+    std::cerr << "Usage: " << program
+              << " [--filter SUBSTRING] [--repetitions N] [--output FILE]"
+              << std::endl;
+  }
+
+  void writeJSON(std::ostream& out, size_t repetitions,
+                 const std::vector<BenchResult>& results) {
+    out << "{\"repetitions\": " << repetitions << ", \"benchmarks\": [";
+    for (size_t i = 0; i < results.size(); i++) {
+      auto& result = results[i];
+      auto sorted = result.nsPerOp;
+      std::sort(sorted.begin(), sorted.end());
+
+      out << (i == 0 ? "\n" : ",\n");
+      out << "  {\"name\": \"" << result.name << "\""
+          << ", \"iterations\": " << result.iterations
+          << ", \"min_ns_per_op\": " << sorted.front()
+          << ", \"median_ns_per_op\": " << sorted[sorted.size() / 2]
+          << ", \"max_ns_per_op\": " << sorted.back()
+          << "}";
+    }
+    out << "\n]}" << std::endl;
+  }
+}
+
+std::unique_ptr<mozart::VirtualMachineEnvironment> makeBenchEnvironment() {
+  return std::unique_ptr<BenchEnvironment>(new BenchEnvironment());
+}
+
+namespace mozart { namespace bench {
+
+volatile nativeint benchSink = 0;
+
+std::vector<Benchmark>& registeredBenchmarks() {
+  static std::vector<Benchmark> benchmarks;
+  return benchmarks;
+}
+
+} }
+
+int main(int argc, char** argv) {
+  using namespace mozart::bench;
+
+  std::string filter;
+  std::string outputFile;
+  size_t repetitions = 5;
+
+  for (int i = 1; i < argc; i++) {
+    if (std::strcmp(argv[i], "--filter") == 0 && i+1 < argc) {
+      filter = argv[++i];
+    } else if (std::strcmp(argv[i], "--repetitions") == 0 && i+1 < argc) {
+      repetitions = std::max(1, std::atoi(argv[++i]));
+    } else if (std::strcmp(argv[i], "--output") == 0 && i+1 < argc) {
+      outputFile = argv[++i];
+    } else {
+      usage(argv[0]);
+      return 2;
+    }
+  }
+
+  std::vector<BenchResult> results;
+
+  for (auto& benchmark : registeredBenchmarks()) {
+    if (std::string(benchmark.name).find(filter) == std::string::npos)
+      continue;
+
+    BenchResult result { benchmark.name, benchmark.iterations, {} };
+
+    for (size_t rep = 0; rep < repetitions; rep++) {
+      BenchVM fixture;
+      BenchState state(fixture.vm, benchmark.iterations);
+
+      auto start = std::chrono::steady_clock::now();
+      benchmark.function(state);
+      auto elapsed = state.isTimed() ? state.elapsed() :
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now() - start);
+
+      result.nsPerOp.push_back(
+        (double) elapsed.count() / benchmark.iterations);
+    }
+
+    std::cerr << benchmark.name << ": "
+              << *std::min_element(result.nsPerOp.begin(),
+                                   result.nsPerOp.end())
+              << " ns/op" << std::endl;
+    results.push_back(std::move(result));
+  }
+
+  if (outputFile.empty()) {
+    writeJSON(std::cout, repetitions, results);
+  } else {
+    std::ofstream out(outputFile);
+    if (!out) {
+      std::cerr << "Cannot open " << outputFile << std::endl;
+      return 1;
+    }
+    writeJSON(out, repetitions, results);
+  }
+
+  return 0;
+}
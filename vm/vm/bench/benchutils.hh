@@ -0,0 +1,107 @@
+#ifndef MOZART_BENCHUTILS_HH
+#define MOZART_BENCHUTILS_HH
+
+#include "mozart.hh"
+
+#include <chrono>
+#include <vector>
+
+std::unique_ptr<mozart::VirtualMachineEnvironment> makeBenchEnvironment();
+
+namespace mozart { namespace bench {
+
+/**
+ * State handed to a benchmark body
+ * Each run gets a fresh VM. The body does its setup, then brackets the
+ * measured loop of exactly `iterations` operations with startTiming() and
+ * stopTiming(). A body that never calls them is timed as a whole.
+ */
+class BenchState {
+public:
+  BenchState(VM vm, size_t iterations):
+    vm(vm), iterations(iterations), _started(false), _stopped(false) {}
+
+  void startTiming() {
+    _started = true;
+    _start = std::chrono::steady_clock::now();
+  }
+
+  void stopTiming() {
+    _end = std::chrono::steady_clock::now();
+    _stopped = true;
+  }
+
+  bool isTimed() {
+    return _started && _stopped;
+  }
+
+  std::chrono::nanoseconds elapsed() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(_end - _start);
+  }
+
+  VM vm;
+  const size_t iterations;
+private:
+  bool _started;
+  bool _stopped;
+  std::chrono::steady_clock::time_point _start;
+  std::chrono::steady_clock::time_point _end;
+};
+
+typedef void (*BenchFunction)(BenchState& state);
+
+struct Benchmark {
+  const char* name;
+  size_t iterations;
+  BenchFunction function;
+};
+
+std::vector<Benchmark>& registeredBenchmarks();
+
+struct BenchRegistration {
+  BenchRegistration(const char* name, size_t iterations,
+                    BenchFunction function) {
+    registeredBenchmarks().push_back({ name, iterations, function });
+  }
+};
+
+/**
+ * Sink for results computed in a measured loop, so that the compiler cannot
+ * drop the work that produced them
+ */
+extern volatile nativeint benchSink;
+
+template <typename T>
+inline
+void keep(T value) {
+  benchSink = benchSink + (nativeint) value;
+}
+
+/**
+ * VM fixture for one run of a benchmark, the counterpart of MozartTest
+ */
+class BenchVM {
+public:
+  BenchVM(): environment(makeBenchEnvironment()),
+    virtualMachine(*environment, { 32 * MegaBytes, 512 * MegaBytes }),
+    vm(&virtualMachine) {}
+
+  std::unique_ptr<VirtualMachineEnvironment> environment;
+  VirtualMachine virtualMachine;
+  VM vm;
+};
+
+} }
+
+/**
+ * Define and register a benchmark performing a fixed number of iterations
+ * Iteration counts are part of the benchmark and never adapted at run time,
+ * so that results are comparable across runs and machines.
+ */
+#define MOZART_BENCH(name, iterations) \
+  static void name##Bench(::mozart::bench::BenchState& state); \
+  static ::mozart::bench::BenchRegistration name##Registration( \
+    #name, iterations, &name##Bench); \
+  static void name##Bench(::mozart::bench::BenchState& state)
+
+#endif // MOZART_BENCHUTILS_HH
@@ -0,0 +1,318 @@
+#include "mozart.hh"
+#include "benchutils.hh"
+
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <sstream>
+
+using namespace mozart;
+using namespace mozart::bench;
+
+namespace {
+  /** Complete binary tree of node(L R) tuples with integer leaves */
+  UnstableNode buildTree(VM vm, int depth, nativeint& counter) {
+    if (depth == 0)
+      return build(vm, counter++);
+
+    auto left = buildTree(vm, depth-1, counter);
+    auto right = buildTree(vm, depth-1, counter);
+    return buildTuple(vm, "node", std::move(left), std::move(right));
+  }
+
+  UnstableNode buildTree(VM vm, int depth) {
+    nativeint counter = 0;
+    return buildTree(vm, depth, counter);
+  }
+
+  /** List of `length` point(I atom) tuples */
+  UnstableNode buildPoints(VM vm, size_t length) {
+    UnstableNode list = build(vm, vm->coreatoms.nil);
+    for (size_t i = length; i > 0; i--) {
+      list = buildCons(vm, buildTuple(vm, "point", (nativeint) i, "atom"),
+                       std::move(list));
+    }
+    return list;
+  }
+
+  /** Floats with random bit patterns, covering all exponents */
+  std::vector<double> randomFloats(size_t count) {
+    std::mt19937_64 random(42);
+    std::vector<double> result;
+    while (result.size() < count) {
+      std::uint64_t bits = random();
+      double value;
+      std::memcpy(&value, &bits, sizeof(value));
+      if (std::isfinite(value))
+        result.push_back(value);
+    }
+    return result;
+  }
+
+  /** List of `length` floats with a few significant digits */
+  UnstableNode buildFloats(VM vm, size_t length) {
+    UnstableNode list = build(vm, vm->coreatoms.nil);
+    for (size_t i = length; i > 0; i--)
+      list = buildCons(vm, i * 1.25e-3, std::move(list));
+    return list;
+  }
+}
+
+////////////////////
+// Memory manager //
+////////////////////
+
+MOZART_BENCH(MemoryManagerMallocFree, 1000000) {
+  auto& mm = state.vm->getMemoryManager();
+
+  state.startTiming();
+  for (size_t i = 0; i < state.iterations; i++) {
+    size_t size = 16 + (i % 15) * 8;
+    void* ptr = mm.malloc(size);
+    mm.free(ptr, size);
+  }
+  state.stopTiming();
+}
+
+////////////////
+// Atom table //
+////////////////
+
+MOZART_BENCH(AtomTableIntern, 500000) {
+  VM vm = state.vm;
+
+  std::vector<std::string> names;
+  for (size_t i = 0; i < 1000; i++)
+    names.push_back("benchAtom" + std::to_string(i));
+
+  state.startTiming();
+  for (size_t i = 0; i < state.iterations; i++) {
+    auto& name = names[i % names.size()];
+    keep(vm->getAtom(name.size(), name.data()).length());
+  }
+  state.stopTiming();
+}
+
+/////////////////////
+// Node dictionary //
+/////////////////////
+
+MOZART_BENCH(NodeDictionaryOps, 200000) {
+  VM vm = state.vm;
+  NodeDictionary dict;
+  UnstableNode* value;
+
+  // Even keys stay in, odd keys are inserted, looked up and removed
+  for (nativeint i = 0; i < 4096; i += 2) {
+    UnstableNode key = build(vm, i);
+    dict.lookupOrCreate(vm, key, value);
+    value->init(vm, build(vm, i));
+  }
+
+  state.startTiming();
+  for (size_t i = 0; i < state.iterations; i++) {
+    UnstableNode key = build(vm, (nativeint) ((i * 2 + 1) % 4096));
+    dict.lookupOrCreate(vm, key, value);
+    value->init(vm, build(vm, unit));
+    keep(dict.lookup(vm, key, value));
+    keep(dict.remove(vm, key));
+  }
+  state.stopTiming();
+
+  dict.removeAll(vm);
+}
+
+//////////////////////////
+// Unification/equality //
+//////////////////////////
+
+MOZART_BENCH(UnifyDeepTrees, 200) {
+  VM vm = state.vm;
+  auto left = buildTree(vm, 12);
+  auto right = buildTree(vm, 12);
+
+  state.startTiming();
+  for (size_t i = 0; i < state.iterations; i++)
+    unify(vm, left, right);
+  state.stopTiming();
+}
+
+MOZART_BENCH(EqualsDeepTrees, 200) {
+  VM vm = state.vm;
+  auto left = buildTree(vm, 12);
+  auto right = buildTree(vm, 12);
+
+  state.startTiming();
+  for (size_t i = 0; i < state.iterations; i++)
+    keep(equals(vm, left, right));
+  state.stopTiming();
+}
+
+///////////
+// Arity //
+///////////
+
+MOZART_BENCH(ArityLookupFeature, 1000000) {
+  VM vm = state.vm;
+  const size_t width = 16;
+
+  UnstableNode features[width];
+  for (size_t i = 0; i < width; i++)
+    features[i] = build(vm, vm->getAtom("f" + std::to_string(i)));
+
+  UnstableNode label = build(vm, "rec");
+  UnstableNode arity = buildArityDynamic(vm, label, width, features);
+  auto impl = RichNode(arity).as<Arity>();
+
+  state.startTiming();
+  for (size_t i = 0; i < state.iterations; i++) {
+    size_t offset = 0;
+    keep(impl.lookupFeature(vm, features[i % width], offset));
+    keep(offset);
+  }
+  state.stopTiming();
+}
+
+//////////////
+// Pickling //
+//////////////
+
+MOZART_BENCH(PickleRoundTrip, 200) {
+  VM vm = state.vm;
+  auto value = buildPoints(vm, 256);
+
+  state.startTiming();
+  for (size_t i = 0; i < state.iterations; i++) {
+    std::stringstream buffer;
+    pickle(vm, value, buffer);
+    auto copy = unpickle(vm, buffer);
+    keep(RichNode(copy).isTransient());
+  }
+  state.stopTiming();
+}
+
+MOZART_BENCH(PickleFloats, 200) {
+  VM vm = state.vm;
+  auto value = buildFloats(vm, 1024);
+
+  state.startTiming();
+  for (size_t i = 0; i < state.iterations; i++) {
+    std::stringstream buffer;
+    pickle(vm, value, buffer);
+    auto copy = unpickle(vm, buffer);
+    keep(RichNode(copy).isTransient());
+  }
+  state.stopTiming();
+}
+
+////////////////////////
+// Number conversions //
+////////////////////////
+
+MOZART_BENCH(FormatFloat, 1000000) {
+  auto values = randomFloats(4096);
+  char buffer[NumberFormatBufferSize];
+
+  state.startTiming();
+  for (size_t i = 0; i < state.iterations; i++)
+    keep(formatFloat(buffer, values[i % values.size()]));
+  state.stopTiming();
+}
+
+MOZART_BENCH(ParseFloat, 1000000) {
+  std::vector<std::string> strings;
+  for (double value : randomFloats(4096)) {
+    char buffer[NumberFormatBufferSize];
+    strings.emplace_back(buffer, formatFloat(buffer, value));
+  }
+
+  state.startTiming();
+  for (size_t i = 0; i < state.iterations; i++) {
+    auto& str = strings[i % strings.size()];
+    double value;
+    keep(parseFloat(str.data(), str.data() + str.size(), value));
+  }
+  state.stopTiming();
+}
+
+MOZART_BENCH(FormatInt, 1000000) {
+  char buffer[NumberFormatBufferSize];
+
+  state.startTiming();
+  for (size_t i = 0; i < state.iterations; i++)
+    keep(formatInt(buffer, (nativeint) (i * 2654435761u) - 1000000000));
+  state.stopTiming();
+}
+
+MOZART_BENCH(ParseInt, 1000000) {
+  std::vector<std::string> strings;
+  for (nativeint i = 0; i < 4096; i++)
+    strings.push_back(std::to_string(i * 2654435761LL - 1000000000));
+
+  state.startTiming();
+  for (size_t i = 0; i < state.iterations; i++) {
+    auto& str = strings[i % strings.size()];
+    nativeint value;
+    parseInt(str.data(), str.data() + str.size(), value);
+    keep(value);
+  }
+  state.stopTiming();
+}
+
+MOZART_BENCH(FloatToVirtualString, 500000) {
+  VM vm = state.vm;
+  auto values = randomFloats(4096);
+  std::vector<char> buffer;
+
+  state.startTiming();
+  for (size_t i = 0; i < state.iterations; i++) {
+    UnstableNode node = build(vm, values[i % values.size()]);
+    buffer.clear();
+    ozVSGet(vm, node, buffer);
+    keep(buffer.size());
+  }
+  state.stopTiming();
+}
+
+///////////////////
+// Space cloning //
+///////////////////
+
+MOZART_BENCH(SpaceClone, 500) {
+  VM vm = state.vm;
+  Space* space = new (vm) Space(vm, vm->getCurrentSpace());
+
+  // Bind the root variable to a structure holding variables local to space
+  space->install();
+  UnstableNode list = build(vm, vm->coreatoms.nil);
+  for (nativeint i = 0; i < 1000; i++) {
+    list = buildCons(vm, buildTuple(vm, "cell", i, Variable::build(vm)),
+                     std::move(list));
+  }
+  unify(vm, *space->getRootVar(), list);
+  vm->getTopLevelSpace()->install();
+
+  state.startTiming();
+  for (size_t i = 0; i < state.iterations; i++)
+    keep(space->clone(vm)->isAlive());
+  state.stopTiming();
+}
+
+////////////////////////
+// Garbage collection //
+////////////////////////
+
+MOZART_BENCH(FullGC, 20) {
+  VM vm = state.vm;
+  auto heap = vm->protect(buildPoints(vm, 100000));
+
+  vm->requestGC();
+  vm->run();
+
+  state.startTiming();
+  for (size_t i = 0; i < state.iterations; i++) {
+    vm->requestGC();
+    vm->run();
+  }
+  state.stopTiming();
+}
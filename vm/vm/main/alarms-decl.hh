@@ -0,0 +1,133 @@
+// Copyright © 2014, Université catholique de Louvain
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// *  Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// *  Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef MOZART_ALARMS_DECL_H
+#define MOZART_ALARMS_DECL_H
+
+#include "core-forward-decl.hh"
+
+#include "store-decl.hh"
+#include "vmallocatedlist-decl.hh"
+
+namespace mozart {
+
+////////////////
+// AlarmWheel //
+////////////////
+
+/**
+ * Pending alarms of a VM, stored in a hierarchical timing wheel.
+ *
+ * Level L has 64 slots of 64^L ms each. An alarm is put in the level that
+ * corresponds to the magnitude of its remaining delay, in the slot of its
+ * expiration time, so that insertion is O(1). When the time advances, the
+ * slots that were passed over are emptied and their alarms are inserted
+ * anew, either in a lower level or in the list of expired alarms. Each alarm
+ * is moved at most once per level before it expires.
+ *
+ * Slots are unsorted lists, hence alarms that expire during the same call to
+ * advance() are not ordered by expiration time.
+ */
+class AlarmWheel {
+private:
+  struct AlarmRecord {
+    AlarmRecord(std::int64_t expiration, StableNode* wakeable):
+      expiration(expiration), wakeable(wakeable) {}
+
+    std::int64_t expiration;
+    StableNode* wakeable;
+  };
+
+  typedef VMAllocatedList<AlarmRecord> AlarmList;
+
+  static const size_t LevelBits = 6;
+  static const size_t LevelCount = 6;
+  static const size_t SlotCount = (size_t) 1 << LevelBits;
+  static const std::uint64_t SlotMask = SlotCount - 1;
+
+  /** Remaining delays are capped to what the whole wheel can represent */
+  static const std::uint64_t MaxRemaining =
+    ((std::uint64_t) 1 << (LevelBits * LevelCount)) - 1;
+public:
+  AlarmWheel(): _currentTime(0) {
+    for (size_t level = 0; level < LevelCount; level++)
+      _pending[level] = 0;
+  }
+
+  inline
+  bool empty();
+
+  /** Schedule an alarm that wakes up wakeable at the given expiration */
+  inline
+  void insert(VM vm, std::int64_t expiration, StableNode* wakeable);
+
+  /** Advance the time of the wheel, collecting the alarms that expire */
+  inline
+  void advance(VM vm, std::int64_t now);
+
+  bool hasExpired() {
+    return !_expired.empty();
+  }
+
+  /** Remove one expired alarm and return its wakeable */
+  inline
+  StableNode* popExpired(VM vm);
+
+  /**
+   * Lower bound on the expiration time of the earliest pending alarm.
+   * It is exact if that alarm is in the lowest level. Otherwise, the VM is
+   * simply invoked a bit too early, at which point the wheel is advanced
+   * and can give a more accurate time.
+   * Runs in O(LevelCount). The wheel must not be empty.
+   */
+  inline
+  std::int64_t nextExpiration();
+
+  inline
+  void gCollect(GC gc);
+private:
+  inline
+  AlarmList& listFor(std::int64_t expiration);
+
+  inline
+  void gCollect(GC gc, AlarmList& list);
+
+  static std::uint64_t rotl(std::uint64_t value, size_t count) {
+    return (value << count) | (value >> ((64 - count) & 63));
+  }
+
+  static std::uint64_t rotr(std::uint64_t value, size_t count) {
+    return (value >> count) | (value << ((64 - count) & 63));
+  }
+
+  std::int64_t _currentTime;
+
+  AlarmList _slots[LevelCount][SlotCount];
+  std::uint64_t _pending[LevelCount]; // bitmaps of the non-empty slots
+  AlarmList _expired;
+};
+
+}
+
+#endif // MOZART_ALARMS_DECL_H
@@ -0,0 +1,188 @@
+// Copyright © 2014, Université catholique de Louvain
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// *  Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// *  Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef MOZART_ALARMS_H
+#define MOZART_ALARMS_H
+
+#include "mozartcore.hh"
+
+#ifndef MOZART_GENERATOR
+
+namespace mozart {
+
+////////////////
+// AlarmWheel //
+////////////////
+
+bool AlarmWheel::empty() {
+  if (!_expired.empty())
+    return false;
+
+  for (size_t level = 0; level < LevelCount; level++) {
+    if (_pending[level] != 0)
+      return false;
+  }
+
+  return true;
+}
+
+void AlarmWheel::insert(VM vm, std::int64_t expiration,
+                        StableNode* wakeable) {
+  listFor(expiration).push_back_new(vm, expiration, wakeable);
+}
+
+void AlarmWheel::advance(VM vm, std::int64_t now) {
+  if (now <= _currentTime)
+    return;
+
+  std::uint64_t elapsed = now - _currentTime;
+  AlarmList todo;
+
+  for (size_t level = 0; level < LevelCount; level++) {
+    size_t shift = level * LevelBits;
+
+    // Slots of this level that are passed over between _currentTime and now
+    std::uint64_t passed;
+    if ((elapsed >> shift) > SlotMask) {
+      passed = ~(std::uint64_t) 0;
+    } else {
+      size_t levelElapsed = (elapsed >> shift) & SlotMask;
+      size_t oldSlot = (_currentTime >> shift) & SlotMask;
+      size_t newSlot = (now >> shift) & SlotMask;
+      std::uint64_t range = ((std::uint64_t) 1 << levelElapsed) - 1;
+
+      passed = rotl(range, oldSlot);
+      passed |= rotr(rotl(range, newSlot), levelElapsed);
+      passed |= (std::uint64_t) 1 << newSlot;
+    }
+
+    std::uint64_t hits = passed & _pending[level];
+    while (hits != 0) {
+      size_t slot = __builtin_ctzll(hits);
+      todo.splice(vm, _slots[level][slot]);
+      hits &= hits - 1;
+    }
+    _pending[level] &= ~passed;
+
+    // Higher levels only need to be looked at if this one wrapped around
+    if ((passed & 1) == 0)
+      break;
+
+    // In which case the next level has ticked at least once
+    elapsed = std::max(elapsed, (std::uint64_t) SlotCount << shift);
+  }
+
+  _currentTime = now;
+
+  // Redistribute the collected alarms, reusing their list nodes
+  auto iter = todo.removable_begin();
+  while (iter != todo.removable_end())
+    listFor(iter->expiration).splice(vm, todo, iter);
+}
+
+StableNode* AlarmWheel::popExpired(VM vm) {
+  return _expired.pop_front(vm).wakeable;
+}
+
+std::int64_t AlarmWheel::nextExpiration() {
+  assert(!empty());
+
+  if (!_expired.empty())
+    return _currentTime;
+
+  std::uint64_t result = ~(std::uint64_t) 0;
+  std::uint64_t lowerLevelsMask = 0;
+
+  for (size_t level = 0; level < LevelCount; level++) {
+    size_t shift = level * LevelBits;
+
+    if (_pending[level] != 0) {
+      size_t currentSlot = (_currentTime >> shift) & SlotMask;
+      std::uint64_t slotDistance =
+        __builtin_ctzll(rotr(_pending[level], currentSlot));
+
+      // Alarms of higher levels are one slot further than their index says
+      std::uint64_t delay =
+        (slotDistance + (level == 0 ? 0 : 1)) << shift;
+      delay -= lowerLevelsMask & _currentTime;
+
+      result = std::min(result, delay);
+    }
+
+    lowerLevelsMask = (lowerLevelsMask << LevelBits) | SlotMask;
+  }
+
+  return _currentTime + result;
+}
+
+void AlarmWheel::gCollect(GC gc) {
+  for (size_t level = 0; level < LevelCount; level++) {
+    std::uint64_t pending = _pending[level];
+    while (pending != 0) {
+      size_t slot = __builtin_ctzll(pending);
+      gCollect(gc, _slots[level][slot]);
+      pending &= pending - 1;
+    }
+  }
+
+  gCollect(gc, _expired);
+}
+
+AlarmWheel::AlarmList& AlarmWheel::listFor(std::int64_t expiration) {
+  if (expiration <= _currentTime)
+    return _expired;
+
+  std::uint64_t remaining = expiration - _currentTime;
+  if (remaining > MaxRemaining)
+    remaining = MaxRemaining;
+  size_t highestBit = 63 - __builtin_clzll(remaining);
+  size_t level = highestBit / LevelBits;
+  size_t shift = level * LevelBits;
+
+  /* In levels above 0, alarms are put one slot before the one of their
+   * expiration, so that they are redistributed when the previous level
+   * wraps around into their actual slot. */
+  size_t slot = (((std::uint64_t) expiration >> shift) -
+    (level == 0 ? 0 : 1)) & SlotMask;
+
+  _pending[level] |= (std::uint64_t) 1 << slot;
+  return _slots[level][slot];
+}
+
+void AlarmWheel::gCollect(GC gc, AlarmList& list) {
+  // The nodes of the old list live in the from-space, which is still valid
+  AlarmList oldList = list;
+  list = AlarmList();
+
+  for (auto iter = oldList.begin(); iter != oldList.end(); ++iter) {
+    list.push_back_new(gc->vm, iter->expiration, iter->wakeable);
+    gc->copyStableRef(list.back().wakeable, list.back().wakeable);
+  }
+}
+
+}
+
+#endif // MOZART_GENERATOR
+
+#endif // MOZART_ALARMS_H
@@ -374,6 +374,12 @@ struct InlineAs {
   }
 };
 
+/**
+ * The opcode given by InlineAs is implemented by hand in the emulator, so
+ * that it can be quickened. The generator must not emit its case.
+ */
+struct NoAutoInline {};
+
 }
 
 }
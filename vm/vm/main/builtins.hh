@@ -97,7 +97,9 @@ void BaseBuiltin::buildCodeBlock(VM vm, RichNode self) {
     case 3: _codeBlock[index++] = OpCallBuiltin3; break;
     case 4: _codeBlock[index++] = OpCallBuiltin4; break;
     case 5: _codeBlock[index++] = OpCallBuiltin5; break;
-    default: _codeBlock[index++] = OpCallBuiltinN; break;
+    // This block is shared by all VMs, so it must never be rewritten by the
+    // emulator. Since K(0) is this very builtin, quicken it right away.
+    default: _codeBlock[index++] = OpQuickCallBuiltinN; break;
   }
 
   _codeBlock[index++] = 0; // K(0)
@@ -97,6 +97,21 @@ private:
     std::memcpy(_codeBlock, codeBlock, size);
   }
 
+  /**
+   * Copy of the code block where quickened opcodes are turned back into
+   * their generic form, so that serialized code does not depend on the type
+   * feedback gathered by the emulator
+   */
+  inline
+  ByteCode* _genericCodeBlock(VM vm);
+
+  /**
+   * Size, in ByteCode's, of the instruction at PC, or 0 if unknown
+   * Every opcode of opcodes.hh must be known here.
+   */
+  inline
+  static size_t _instructionSize(ProgramCounter PC);
+
   GlobalNode* _gnode;
 
   ByteCode* _codeBlock; // actual byte-code in this code area
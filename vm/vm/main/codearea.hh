@@ -27,6 +27,9 @@
 
 #include "mozartcore.hh"
 
+#include <cstdlib>
+#include <iostream>
+
 #ifndef MOZART_GENERATOR
 
 namespace mozart {
@@ -100,7 +103,7 @@ void CodeArea::printReprToStream(VM vm, std::ostream& out,
 UnstableNode CodeArea::serialize(VM vm, SE se) {
   UnstableNode codeAtom = mozart::build(vm, "code");
   UnstableNode block = buildTupleDynamic(
-    vm, codeAtom, _size / sizeof(ByteCode), _codeBlock,
+    vm, codeAtom, _size / sizeof(ByteCode), _genericCodeBlock(vm),
     [=](ByteCode b) {
       return mozart::build(vm, (nativeint) b);
     });
@@ -122,6 +125,112 @@ UnstableNode CodeArea::serialize(VM vm, SE se) {
   return result;
 }
 
+ByteCode* CodeArea::_genericCodeBlock(VM vm) {
+  size_t count = _size / sizeof(ByteCode);
+  ByteCode* result = new (vm) ByteCode[count];
+  std::memcpy(result, _codeBlock, _size);
+
+  size_t index = 0;
+  while (index < count) {
+    size_t instrSize = _instructionSize(result + index);
+    if (instrSize == 0) {
+      // Past this point, quickened opcodes could not be found, and would
+      // end up in pickles that other VMs cannot read
+      assert(false && "unknown opcode in code area");
+      std::cerr << "Unknown opcode met while serializing a code area: ";
+      std::cerr << (int) result[index] << std::endl;
+      std::abort();
+    }
+
+    result[index] = genericOpCode(result[index]);
+    index += instrSize;
+  }
+
+  return result;
+}
+
+size_t CodeArea::_instructionSize(ProgramCounter PC) {
+  OpCode op = genericOpCode(*PC);
+
+  if ((op & ~(OpCode) 0x1F) == OpCreateStructBase) {
+    // 3 arguments, then a sub-opcode with 1 argument for each element, except
+    // that SubOpArrayFillNewVars accounts for several elements at once
+    size_t length = PC[2];
+    size_t size = 4;
+    for (size_t index = 0; index < length; index++) {
+      if (PC[size] == SubOpArrayFillNewVars)
+        index += PC[size+1] - 1;
+      size += 2;
+    }
+    return size;
+  }
+
+  switch (op) {
+    case OpSkip:
+    case OpPopExceptionHandler:
+    case OpReturn:
+      return 1;
+
+    case OpLocalVarname:
+    case OpGlobalVarname:
+    case OpClearY:
+    case OpAllocateY:
+    case OpCreateVarX:
+    case OpCreateVarY:
+    case OpSetupExceptionHandler:
+    case OpBranch:
+    case OpBranchBackward:
+    case OpCallBuiltin0:
+      return 2;
+
+    case OpMoveXX: case OpMoveXY: case OpMoveYX: case OpMoveYY:
+    case OpMoveGX: case OpMoveGY: case OpMoveKX: case OpMoveKY:
+    case OpCreateVarMoveX:
+    case OpCreateVarMoveY:
+    case OpCallBuiltin1:
+    case OpCallX: case OpCallY: case OpCallG: case OpCallK:
+    case OpTailCallX: case OpTailCallY: case OpTailCallG: case OpTailCallK:
+    case OpPatternMatchX: case OpPatternMatchY: case OpPatternMatchG:
+    case OpUnifyXX: case OpUnifyXY: case OpUnifyXG: case OpUnifyXK:
+    case OpUnifyYY: case OpUnifyYG: case OpUnifyYK:
+    case OpUnifyGG: case OpUnifyGK: case OpUnifyKK:
+    case OpInlinePlus1:
+    case OpInlineMinus1:
+    case OpInlineGetClass:
+      return 3;
+
+    case OpCallBuiltin2:
+    case OpSendMsgX: case OpSendMsgY: case OpSendMsgG: case OpSendMsgK:
+    case OpTailSendMsgX: case OpTailSendMsgY:
+    case OpTailSendMsgG: case OpTailSendMsgK:
+    case OpCondBranch: case OpCondBranchFB:
+    case OpCondBranchBF: case OpCondBranchBB:
+    case OpInlineEqualsInteger:
+    case OpInlineAdd:
+    case OpInlineSubtract:
+      return 4;
+
+    case OpMoveMoveXYXY: case OpMoveMoveYXYX:
+    case OpMoveMoveYXXY: case OpMoveMoveXYYX:
+    case OpCallBuiltin3:
+    case OpDebugEntry:
+    case OpDebugExit:
+      return 5;
+
+    case OpCallBuiltin4:
+      return 6;
+
+    case OpCallBuiltin5:
+      return 7;
+
+    case OpCallBuiltinN:
+      return 3 + PC[2];
+
+    default:
+      return 0;
+  }
+}
+
 GlobalNode* CodeArea::globalize(RichNode self, VM vm) {
   if (_gnode == nullptr) {
     _gnode = GlobalNode::make(vm, self, "immval");
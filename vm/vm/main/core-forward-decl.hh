@@ -152,6 +152,8 @@ class TypeInfoOf;
 
 class NodeDictionary;
 
+class WeakDictionary;
+
 class Space;
 
 /**
@@ -418,7 +418,7 @@ class BaseDottable;
 template<>
 struct Interface<BaseDottable>:
   ImplementedBy<Tuple, Record, Object, Chunk, Cons, Array, Dictionary,
-    Atom, OptName, GlobalName, Boolean, Unit> {
+    WeakDictionary, Atom, OptName, GlobalName, Boolean, Unit> {
 
   bool lookupFeature(RichNode self, VM vm, RichNode feature,
                      nullable<UnstableNode&> value) {
@@ -434,7 +434,7 @@ struct Interface<BaseDottable>:
 class DotAssignable;
 template<>
 struct Interface<DotAssignable>:
-  ImplementedBy<Array, Dictionary> {
+  ImplementedBy<Array, Dictionary, WeakDictionary> {
 
   void dotAssign(RichNode self, VM vm, RichNode feature, RichNode newValue) {
     raiseTypeError(vm, "Array or Dictionary", self);
@@ -659,6 +659,10 @@ struct Interface<SpaceLike>:
     raiseTypeError(vm, "Space", self);
   }
 
+  void injectSpace(RichNode self, VM vm, RichNode callable) {
+    raiseTypeError(vm, "Space", self);
+  }
+
   void killSpace(RichNode self, VM vm) {
     raiseTypeError(vm, "Space", self);
   }
@@ -52,6 +52,7 @@ void registerCoreModules(VM vm) {
   registerBuiltinModFloat(vm);
   registerBuiltinModForeignPointer(vm);
   registerBuiltinModGNode(vm);
+  registerBuiltinModList(vm);
   registerBuiltinModLiteral(vm);
   registerBuiltinModName(vm);
   registerBuiltinModNumber(vm);
@@ -59,6 +60,7 @@ void registerCoreModules(VM vm) {
   registerBuiltinModPickle(vm);
   registerBuiltinModPort(vm);
   registerBuiltinModProcedure(vm);
+  registerBuiltinModProfile(vm);
   registerBuiltinModProperty(vm);
   registerBuiltinModRecord(vm);
   registerBuiltinModReflection(vm);
@@ -71,6 +73,7 @@ void registerCoreModules(VM vm) {
   registerBuiltinModValue(vm);
   registerBuiltinModVirtualByteString(vm);
   registerBuiltinModVirtualString(vm);
+  registerBuiltinModWeakDictionary(vm);
   registerBuiltinModWeakReference(vm);
 }
 
@@ -43,6 +43,7 @@
 #include "modules/modfloat.hh"
 #include "modules/modforeignpointer.hh"
 #include "modules/modgnode.hh"
+#include "modules/modlist.hh"
 #include "modules/modliteral.hh"
 #include "modules/modname.hh"
 #include "modules/modnumber.hh"
@@ -50,6 +51,7 @@
 #include "modules/modpickle.hh"
 #include "modules/modport.hh"
 #include "modules/modprocedure.hh"
+#include "modules/modprofile.hh"
 #include "modules/modproperty.hh"
 #include "modules/modrecord.hh"
 #include "modules/modreflection.hh"
@@ -62,6 +64,7 @@
 #include "modules/modvalue.hh"
 #include "modules/modvirtualbytestring.hh"
 #include "modules/modvirtualstring.hh"
+#include "modules/modweakdict.hh"
 #include "modules/modweakref.hh"
 
 #endif // MOZART_COREMODULES_H
@@ -94,6 +94,10 @@ inline
 UnstableNode buildRecordDynamic(VM vm, RichNode label, size_t width,
                                 UnstableField elements[]);
 
+inline
+UnstableNode buildRecordDynamicSorted(VM vm, RichNode label, size_t width,
+                                      UnstableField elements[]);
+
 }
 
 #endif // MOZART_DYNBUILDERS_DECL_H
@@ -219,6 +219,38 @@ UnstableNode buildRecordDynamic(VM vm, RichNode label, size_t width,
   return result;
 }
 
+/**
+ * Build a record from fields that are already sorted by feature
+ * The label must be a literal, and the features must be valid and distinct.
+ * Unlike buildRecordDynamic(), nothing is checked nor sorted, which saves
+ * the O(n log n) pass when the caller merged sorted arities itself.
+ */
+UnstableNode buildRecordDynamicSorted(VM vm, RichNode label, size_t width,
+                                      UnstableField elements[]) {
+  // Optimized representation for tuples
+  if (internal::isTupleFeatureArray(vm, width, elements)) {
+    return buildTupleDynamic(vm, label, width, elements,
+      [] (UnstableField& element) -> UnstableNode& { return element.value; });
+  }
+
+  // Make the arity
+  auto arity = Arity::build(vm, width, label);
+  auto arityImpl = RichNode(arity).as<Arity>();
+
+  for (size_t i = 0; i < width; i++)
+    arityImpl.getElement(i)->init(vm, elements[i].feature);
+
+  // Allocate the record
+  auto result = Record::build(vm, width, arity);
+  auto record = RichNode(result).as<Record>();
+
+  // Fill the elements
+  for (size_t i = 0; i < width; i++)
+    record.getElement(i)->init(vm, elements[i].value);
+
+  return result;
+}
+
 }
 
 #endif // MOZART_GENERATOR
@@ -337,6 +337,11 @@ void Thread::run() {
 #define GPC(offset) (gregs)[PC[offset]]
 #define KPC(offset) (kregs)[PC[offset]]
 
+  // Quickening - see opcodes.hh
+
+#define rewriteOpCode(newOp) \
+  do { *const_cast<ByteCode*>(PC) = (newOp); } while (0)
+
   // Preemption
 
   bool preempted = false;
@@ -552,7 +557,30 @@ void Thread::run() {
           for (size_t i = 0; i < argc; i++)
             args[i] = &XPC(3 + i);
 
-          BuiltinCallable(KPC(1)).callBuiltin(vm, argc, args);
+          RichNode builtin = KPC(1);
+          if (builtin.is<BuiltinProcedure>())
+            rewriteOpCode(OpQuickCallBuiltinN);
+
+          BuiltinCallable(builtin).callBuiltin(vm, argc, args);
+
+          advancePC(2 + argc);
+          break;
+        }
+
+        case OpQuickCallBuiltinN: {
+          size_t argc = IntPC(2);
+
+          UnstableNode* args[argc];
+          for (size_t i = 0; i < argc; i++)
+            args[i] = &XPC(3 + i);
+
+          RichNode builtin = KPC(1);
+          if (builtin.is<BuiltinProcedure>()) {
+            builtin.as<BuiltinProcedure>().value()->callBuiltin(vm, args);
+          } else {
+            rewriteOpCode(OpCallBuiltinN);
+            BuiltinCallable(builtin).callBuiltin(vm, argc, args);
+          }
 
           advancePC(2 + argc);
           break;
@@ -803,6 +831,30 @@ void Thread::run() {
         }
 
         case OpUnifyXK: {
+          RichNode left = XPC(1), right = KPC(2);
+          if (left.is<Atom>() && right.is<Atom>())
+            rewriteOpCode(OpQuickUnifyXKAtom);
+
+          unify(vm, left, right);
+          advancePC(2);
+          break;
+        }
+
+        case OpQuickUnifyXKAtom: {
+          RichNode left = XPC(1), right = KPC(2);
+          if (left.is<Atom>() && right.is<Atom>()) {
+            if (left.as<Atom>().value() != right.as<Atom>().value())
+              fail(vm);
+          } else {
+            rewriteOpCode(OpPolyUnifyXK);
+            unify(vm, left, right);
+          }
+
+          advancePC(2);
+          break;
+        }
+
+        case OpPolyUnifyXK: {
           unify(vm, XPC(1), KPC(2));
           advancePC(2);
           break;
@@ -1186,6 +1238,124 @@ void Thread::run() {
           break;
         }
 
+        case OpInlineAdd: {
+          RichNode left = XPC(1), right = XPC(2);
+          if (left.is<SmallInt>() && right.is<SmallInt>())
+            rewriteOpCode(OpQuickAddInt);
+
+          builtins::ModNumber::Add::call(vm, XPC(1), XPC(2), XPC(3));
+          advancePC(3);
+          break;
+        }
+
+        case OpQuickAddInt: {
+          RichNode left = XPC(1), right = XPC(2);
+          if (left.is<SmallInt>() && right.is<SmallInt>()) {
+            XPC(3) = left.as<SmallInt>().add(
+              vm, right.as<SmallInt>().value());
+          } else {
+            rewriteOpCode(OpPolyInlineAdd);
+            builtins::ModNumber::Add::call(vm, XPC(1), XPC(2), XPC(3));
+          }
+
+          advancePC(3);
+          break;
+        }
+
+        case OpPolyInlineAdd: {
+          builtins::ModNumber::Add::call(vm, XPC(1), XPC(2), XPC(3));
+          advancePC(3);
+          break;
+        }
+
+        case OpInlineSubtract: {
+          RichNode left = XPC(1), right = XPC(2);
+          if (left.is<SmallInt>() && right.is<SmallInt>())
+            rewriteOpCode(OpQuickSubtractInt);
+
+          builtins::ModNumber::Subtract::call(vm, XPC(1), XPC(2), XPC(3));
+          advancePC(3);
+          break;
+        }
+
+        case OpQuickSubtractInt: {
+          RichNode left = XPC(1), right = XPC(2);
+          if (left.is<SmallInt>() && right.is<SmallInt>()) {
+            XPC(3) = left.as<SmallInt>().subtractValue(
+              vm, right.as<SmallInt>().value());
+          } else {
+            rewriteOpCode(OpPolyInlineSubtract);
+            builtins::ModNumber::Subtract::call(vm, XPC(1), XPC(2), XPC(3));
+          }
+
+          advancePC(3);
+          break;
+        }
+
+        case OpPolyInlineSubtract: {
+          builtins::ModNumber::Subtract::call(vm, XPC(1), XPC(2), XPC(3));
+          advancePC(3);
+          break;
+        }
+
+        case OpInlinePlus1: {
+          RichNode left = XPC(1);
+          if (left.is<SmallInt>())
+            rewriteOpCode(OpQuickPlus1Int);
+
+          builtins::ModInt::Plus1::call(vm, XPC(1), XPC(2));
+          advancePC(2);
+          break;
+        }
+
+        case OpQuickPlus1Int: {
+          RichNode left = XPC(1);
+          if (left.is<SmallInt>()) {
+            XPC(2) = left.as<SmallInt>().add(vm, 1);
+          } else {
+            rewriteOpCode(OpPolyInlinePlus1);
+            builtins::ModInt::Plus1::call(vm, XPC(1), XPC(2));
+          }
+
+          advancePC(2);
+          break;
+        }
+
+        case OpPolyInlinePlus1: {
+          builtins::ModInt::Plus1::call(vm, XPC(1), XPC(2));
+          advancePC(2);
+          break;
+        }
+
+        case OpInlineMinus1: {
+          RichNode left = XPC(1);
+          if (left.is<SmallInt>())
+            rewriteOpCode(OpQuickMinus1Int);
+
+          builtins::ModInt::Minus1::call(vm, XPC(1), XPC(2));
+          advancePC(2);
+          break;
+        }
+
+        case OpQuickMinus1Int: {
+          RichNode left = XPC(1);
+          if (left.is<SmallInt>()) {
+            XPC(2) = left.as<SmallInt>().add(vm, -1);
+          } else {
+            rewriteOpCode(OpPolyInlineMinus1);
+            builtins::ModInt::Minus1::call(vm, XPC(1), XPC(2));
+          }
+
+          advancePC(2);
+          break;
+        }
+
+        case OpPolyInlineMinus1: {
+          builtins::ModInt::Minus1::call(vm, XPC(1), XPC(2));
+          advancePC(2);
+          break;
+        }
+
 #include "emulate-inline.cc"
 
         default: {
@@ -1241,6 +1411,9 @@ void Thread::run() {
 #undef YPC
 #undef GPC
 #undef KPC
+#undef rewriteOpCode
+
+  vm->getHeapProfiler().setRunningAbstraction(nullptr);
 
   if (isTerminated())
     return;
@@ -1248,6 +1421,11 @@ void Thread::run() {
   // Store the current state in the stack frame, for next invocation of run()
   pushFrame(vm, abstraction, PC, yregCount, yregs, gregs, kregs,
             std::move(debugEntry));
+
+  // This is a safe point to take a profiling sample. A thread that suspended
+  // was waiting rather than running, so only preempted threads are sampled.
+  if (isRunnable() && vm->getProfiler().isSampleDue(vm))
+    vm->getProfiler().sample(vm, stack);
 }
 
 void Thread::pushFrame(VM vm, StableNode* abstraction,
@@ -1279,6 +1457,9 @@ void Thread::popFrame(VM vm, StableNode*& abstraction,
   debugEntry = std::move(entry.debugEntry);
 
   stack.remove_front(vm);
+
+  // Allocations are attributed to the running abstraction
+  vm->getHeapProfiler().setRunningAbstraction(abstraction);
 }
 
 void Thread::call(RichNode target, size_t actualArity, bool isTailCall,
@@ -1331,6 +1512,7 @@ void Thread::call(RichNode target, size_t actualArity, bool isTailCall,
 
   // Setup new frame
   abstraction = stableTarget;
+  vm->getHeapProfiler().setRunningAbstraction(abstraction);
   PC = start;
   xregs->grow(vm, Xcount, formalArity);
   yregCount = 0;
@@ -88,11 +88,23 @@ public:
 
   inline
   atom_t copyAtom(atom_t from);
+
+  // Only for GC: the dictionary's dead entries are finalized after the copy
+  inline
+  void registerWeakDictionary(WeakDictionary* dict);
+
+  // Only for GC, once the copy loop is done: is the given node still alive?
+  inline
+  bool isReplicated(StableNode* from);
 protected:
   template <class Self>
   void runCopyLoop();
 
 private:
+  template <class Self>
+  inline
+  void runMainCopyLoop();
+
   template <class Self>
   inline
   void processSpaceInternal(SpaceRef& space);
@@ -122,6 +134,7 @@ private:
     Node* unstableNodes;
     MemManagedList<StableNode**> stableRefs;
     MemManagedList<StableNode**> weakStableRefs; // only for GC
+    MemManagedList<WeakDictionary*> weakDictionaries; // only for GC
   } todos;
 };
 
@@ -113,8 +113,39 @@ atom_t GraphReplicator::copyAtom(atom_t from) {
     return from;
 }
 
+void GraphReplicator::registerWeakDictionary(WeakDictionary* dict) {
+  assert(kind() == grkGarbageCollection);
+  todos.weakDictionaries.push_front(sourceMM, dict);
+}
+
+bool GraphReplicator::isReplicated(StableNode* from) {
+  RichNode node = *from;
+  return node.is<GRedToStable>() || node.is<GRedToUnstable>();
+}
+
 template <class Self>
 void GraphReplicator::runCopyLoop() {
+  runMainCopyLoop<Self>();
+
+  if (kind() == grkGarbageCollection) {
+    // Finalizing weak dictionaries resurrects their dead values, which may in
+    // turn reach other weak dictionaries
+    while (!todos.weakDictionaries.empty()) {
+      while (!todos.weakDictionaries.empty())
+        todos.weakDictionaries.pop_front(sourceMM)->finalizeDeadEntries(this);
+
+      runMainCopyLoop<Self>();
+    }
+
+    while (!todos.weakStableRefs.empty()) {
+      processStableRefInternal<Self, /* weak = */ true>(
+        *todos.weakStableRefs.pop_front(sourceMM));
+    }
+  }
+}
+
+template <class Self>
+void GraphReplicator::runMainCopyLoop() {
   while (!todos.spaces.empty() ||
          !todos.threads.empty() ||
          todos.stableNodes != nullptr ||
@@ -138,13 +169,6 @@ void GraphReplicator::runCopyLoop() {
         *todos.stableRefs.pop_front(sourceMM));
     }
   }
-
-  if (kind() == grkGarbageCollection) {
-    while (!todos.weakStableRefs.empty()) {
-      processStableRefInternal<Self, /* weak = */ true>(
-        *todos.weakStableRefs.pop_front(sourceMM));
-    }
-  }
 }
 
 template <class Self>
@@ -0,0 +1,186 @@
+// Copyright © 2014, Université catholique de Louvain
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// *  Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// *  Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef MOZART_HEAPPROFILER_DECL_H
+#define MOZART_HEAPPROFILER_DECL_H
+
+#include <ostream>
+#include <string>
+#include <unordered_map>
+
+#include "core-forward-decl.hh"
+
+#include "type-decl.hh"
+
+namespace mozart {
+
+//////////////////
+// HeapProfiler //
+//////////////////
+
+/**
+ * Heap profiling of a VM, in two independent modes.
+ *
+ * Allocation profiling counts the nodes that are allocated in the heap, per
+ * type and per allocating procedure. Only one allocation out of
+ * sampleInterval is actually recorded, with a weight of sampleInterval, so
+ * that the overhead stays low enough for production use.
+ *
+ * The heap census counts the live nodes and bytes per type. It is computed
+ * during garbage collection, from the nodes that are copied, and replaced at
+ * each GC.
+ *
+ * Values stored directly in a node (e.g., small integers and atoms) do not
+ * use heap memory and are not counted.
+ *
+ * Allocations are attributed to the code area of the running abstraction, so
+ * that all the closures of a procedure make up a single site. Sites are
+ * recorded by procedure name and do not keep anything alive. The name of a
+ * code area is resolved once per GC cycle, on the first sample attributed to
+ * it, as code areas move during GC.
+ */
+class HeapProfiler {
+public:
+  struct Counters {
+    Counters(): count(0), bytes(0) {}
+
+    size_t count;
+    size_t bytes;
+  };
+public:
+  HeapProfiler(): _allocEnabled(false), _sampleInterval(1), _countdown(1),
+    _sampling(false), _runningAbstraction(nullptr),
+    _censusEnabled(false), _inGC(false), _censusGC(0) {}
+
+// Allocation profiling
+
+  bool isProfilingAllocations() {
+    return _allocEnabled;
+  }
+
+  void startAllocations(size_t sampleInterval) {
+    _allocEnabled = true;
+    _sampleInterval = sampleInterval > 0 ? sampleInterval : 1;
+    _countdown = _sampleInterval;
+  }
+
+  void stopAllocations() {
+    _allocEnabled = false;
+  }
+
+  /** Called for every node allocated in the heap, including by the GC */
+  inline
+  void recordAllocation(VM vm, Type type, size_t bytes);
+
+  /**
+   * Tell which abstraction is running, to which allocations are attributed.
+   * Pass nullptr when no thread is running.
+   */
+  void setRunningAbstraction(StableNode* abstraction) {
+    _runningAbstraction = abstraction;
+  }
+
+// Heap census
+
+  bool isCensusEnabled() {
+    return _censusEnabled;
+  }
+
+  void setCensusEnabled(bool value) {
+    _censusEnabled = value;
+  }
+
+  /**
+   * Called at the beginning of a GC. The nodes copied by the GC are not
+   * allocations; they make up the new census, if it is enabled.
+   */
+  void beginGC(size_t gcCount) {
+    _inGC = true;
+    _runningAbstraction = nullptr;
+    _siteCache.clear();
+    if (_censusEnabled) {
+      _census.clear();
+      _censusGC = gcCount;
+    }
+  }
+
+  void endGC() {
+    _inGC = false;
+  }
+
+// Results
+
+  /** Forget the allocations recorded so far and the last census */
+  void reset() {
+    _allocsByType.clear();
+    _sites.clear();
+    _siteCache.clear();
+    _census.clear();
+    _censusGC = 0;
+  }
+
+  /**
+   * Build the Oz record
+   *   heapProfile(allocations:[type(name:N count:C bytes:B) ...]
+   *               sites:[site(name:N count:C bytes:B) ...]
+   *               census:[type(name:N count:C bytes:B) ...]
+   *               censusGC:G)
+   * where censusGC is the value of gc.count when the census was taken.
+   */
+  UnstableNode buildProfileRecord(VM vm);
+
+  /** Write the results in a human-readable form */
+  void dump(VM vm, std::ostream& out);
+private:
+  void sampleAllocation(VM vm, Type type, size_t bytes);
+
+  void recordLive(Type type, size_t bytes) {
+    Counters& counters = _census[type.info()];
+    counters.count++;
+    counters.bytes += bytes;
+  }
+
+  Counters& runningSiteCounters(VM vm);
+
+  bool _allocEnabled;
+  size_t _sampleInterval;
+  size_t _countdown;
+  bool _sampling;
+  StableNode* _runningAbstraction;
+
+  std::unordered_map<const TypeInfo*, Counters> _allocsByType;
+  std::unordered_map<std::string, Counters> _sites;
+
+  // Sites of the code areas seen since the last GC, keyed by their code block
+  std::unordered_map<const void*, Counters*> _siteCache;
+
+  bool _censusEnabled;
+  bool _inGC;
+  size_t _censusGC;
+  std::unordered_map<const TypeInfo*, Counters> _census;
+};
+
+}
+
+#endif // MOZART_HEAPPROFILER_DECL_H
@@ -0,0 +1,195 @@
+// Copyright © 2014, Université catholique de Louvain
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// *  Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// *  Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include "mozart.hh"
+
+#include <iomanip>
+
+namespace mozart {
+
+//////////////////
+// HeapProfiler //
+//////////////////
+
+namespace {
+  typedef std::unordered_map<const TypeInfo*, HeapProfiler::Counters>
+    TypeTable;
+  typedef std::unordered_map<std::string, HeapProfiler::Counters> SiteTable;
+
+  /** Name of the procedure of an allocation site. Does not raise. */
+  std::string resolveSite(VM vm, StableNode* abstraction) {
+    if (abstraction == nullptr)
+      return "<no thread>";
+
+    RichNode richAbstraction = *abstraction;
+    if (!richAbstraction.is<Abstraction>())
+      return "<P>";
+
+    atom_t printName;
+    UnstableNode debugData;
+    richAbstraction.as<Abstraction>().getDebugInfo(vm, printName, debugData);
+
+    UnstableNode fileNode = Unit::build(vm), lineNode = Unit::build(vm);
+    if (RichNode(debugData).is<Record>()) {
+      Dottable dotDebugData(debugData);
+      fileNode = dotDebugData.condSelect(vm, "file", unit);
+      lineNode = dotDebugData.condSelect(vm, "line", unit);
+    }
+    RichNode file = fileNode, line = lineNode;
+
+    std::string result;
+    if (printName != vm->coreatoms.empty)
+      result.assign(printName.contents(), printName.length());
+    else
+      result = "<P>";
+
+    if (file.is<Atom>() && line.is<SmallInt>()) {
+      atom_t fileName = file.as<Atom>().value();
+      result += ' ';
+      result.append(fileName.contents(), fileName.length());
+      result += ':';
+      result += std::to_string(line.as<SmallInt>().value());
+    }
+
+    return result;
+  }
+
+  UnstableNode buildCountersRecord(VM vm, const char* label,
+                                   const std::string& name,
+                                   const HeapProfiler::Counters& counters) {
+    return buildRecord(
+      vm, buildArity(vm, label, "bytes", "count", "name"),
+      counters.bytes, counters.count, vm->getAtom(name));
+  }
+
+  UnstableNode buildTypeList(VM vm, const TypeTable& table) {
+    OzListBuilder result(vm);
+    for (auto& item: table)
+      result.push_back(vm, buildCountersRecord(vm, "type", item.first->getName(),
+                                               item.second));
+    return result.get(vm);
+  }
+
+  UnstableNode buildSiteList(VM vm, const SiteTable& table) {
+    OzListBuilder result(vm);
+    for (auto& item: table)
+      result.push_back(vm, buildCountersRecord(vm, "site", item.first,
+                                               item.second));
+    return result.get(vm);
+  }
+
+  template <class Key>
+  void dumpTable(std::ostream& out,
+                 const std::unordered_map<Key, HeapProfiler::Counters>& table,
+                 const std::string& (*nameOf)(const Key&)) {
+    out << std::setw(12) << "bytes" << std::setw(12) << "count"
+        << "  name" << std::endl;
+    for (auto& item: table) {
+      out << std::setw(12) << item.second.bytes
+          << std::setw(12) << item.second.count
+          << "  " << nameOf(item.first) << std::endl;
+    }
+  }
+
+  const std::string& typeName(const TypeInfo* const& type) {
+    return type->getName();
+  }
+
+  const std::string& siteName(const std::string& site) {
+    return site;
+  }
+}
+
+void HeapProfiler::sampleAllocation(VM vm, Type type, size_t bytes) {
+  _countdown = _sampleInterval;
+
+  // The tables must not change while the results are built
+  if (_sampling)
+    return;
+
+  Counters& byType = _allocsByType[type.info()];
+  byType.count += _sampleInterval;
+  byType.bytes += bytes * _sampleInterval;
+
+  Counters& bySite = runningSiteCounters(vm);
+  bySite.count += _sampleInterval;
+  bySite.bytes += bytes * _sampleInterval;
+}
+
+HeapProfiler::Counters& HeapProfiler::runningSiteCounters(VM vm) {
+  if (_runningAbstraction == nullptr)
+    return _sites[resolveSite(vm, nullptr)];
+
+  RichNode abstraction = *_runningAbstraction;
+  if (!abstraction.is<Abstraction>())
+    return _sites[resolveSite(vm, _runningAbstraction)];
+
+  // The running abstraction has been called, so its code area info is valid
+  size_t arity, Xcount;
+  ProgramCounter start;
+  StaticArray<StableNode> Gs, Ks;
+  abstraction.as<Abstraction>().getCallInfo(vm, arity, start, Xcount, Gs, Ks);
+
+  auto iter = _siteCache.find(start);
+  if (iter != _siteCache.end())
+    return *iter->second;
+
+  // Resolving the name may allocate, which must not be sampled
+  _sampling = true;
+  Counters& result = _sites[resolveSite(vm, _runningAbstraction)];
+  _sampling = false;
+
+  _siteCache[start] = &result;
+  return result;
+}
+
+UnstableNode HeapProfiler::buildProfileRecord(VM vm) {
+  // The tables must not change while we iterate over them
+  bool wasSampling = _sampling;
+  _sampling = true;
+
+  UnstableNode allocations = buildTypeList(vm, _allocsByType);
+  UnstableNode census = buildTypeList(vm, _census);
+  UnstableNode sites = buildSiteList(vm, _sites);
+
+  _sampling = wasSampling;
+
+  return buildRecord(
+    vm, buildArity(vm, "heapProfile",
+                   "allocations", "census", "censusGC", "sites"),
+    std::move(allocations), std::move(census), _censusGC, std::move(sites));
+}
+
+void HeapProfiler::dump(VM vm, std::ostream& out) {
+  out << "Allocations by type" << std::endl;
+  dumpTable(out, _allocsByType, &typeName);
+
+  out << std::endl << "Allocations by procedure" << std::endl;
+  dumpTable(out, _sites, &siteName);
+
+  out << std::endl << "Live heap after GC " << _censusGC << std::endl;
+  dumpTable(out, _census, &typeName);
+}
+
+}
@@ -39,7 +39,8 @@ class MemoryManager {
 public:
   MemoryManager() : vm(nullptr),
     _nextBlock(nullptr), _baseBlock(nullptr), _blockSize(0),
-    _allocated(0), _allocatedInFreeList(0), _allocatedInExtra(0) {}
+    _allocated(0), _allocatedInFreeList(0), _allocatedInExtra(0),
+    _allocatedInBigBlocks(0) {}
 
   ~MemoryManager() {
     ::free(_baseBlock);
@@ -81,6 +82,7 @@ public:
     } else {
       // Big block - for now use regular malloc/free
       // TODO Allocate a new big block instead
+      _allocatedInBigBlocks += size;
       return ::malloc(size);
     }
   }
@@ -97,6 +99,7 @@ public:
       freeListBuckets[bucket] = ptr;
     } else {
       // Big block - for now use regular malloc/free
+      _allocatedInBigBlocks -= size;
       ::free(ptr);
     }
   }
@@ -129,6 +132,11 @@ public:
     return getAllocated() - getAllocatedInFreeList();
   }
 
+  /** Memory in the big blocks that malloc() gets from ::malloc */
+  size_t getAllocatedInBigBlocks() {
+    return _allocatedInBigBlocks;
+  }
+
 public:
   void swap(MemoryManager& other) {
     std::swap(vm, other.vm);
@@ -140,6 +148,7 @@ public:
     std::swap(_allocatedInFreeList, other._allocatedInFreeList);
     std::swap(_extraAllocs, other._extraAllocs);
     std::swap(_allocatedInExtra, other._allocatedInExtra);
+    std::swap(_allocatedInBigBlocks, other._allocatedInBigBlocks);
   }
 
 private:
@@ -160,6 +169,8 @@ private:
 
   std::forward_list<void*> _extraAllocs;
   size_t _allocatedInExtra; // So it can be reset to 0 after releaseExtraAllocs()
+
+  size_t _allocatedInBigBlocks;
 };
 
 }
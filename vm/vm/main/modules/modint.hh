@@ -68,7 +68,8 @@ public:
     }
   };
 
-  class Plus1: public Builtin<Plus1>, public InlineAs<OpInlinePlus1> {
+  class Plus1: public Builtin<Plus1>, public InlineAs<OpInlinePlus1>,
+    NoAutoInline {
   public:
     Plus1(): Builtin("+1") {}
 
@@ -77,7 +78,8 @@ public:
     }
   };
 
-  class Minus1: public Builtin<Minus1>, public InlineAs<OpInlineMinus1> {
+  class Minus1: public Builtin<Minus1>, public InlineAs<OpInlineMinus1>,
+    NoAutoInline {
   public:
     Minus1(): Builtin("-1") {}
 
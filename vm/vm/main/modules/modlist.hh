@@ -0,0 +1,256 @@
+// Copyright © 2014, Université catholique de Louvain
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// *  Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// *  Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef MOZART_MODLIST_H
+#define MOZART_MODLIST_H
+
+#include "../mozartcore.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#ifndef MOZART_GENERATOR
+
+namespace mozart {
+
+namespace builtins {
+
+/////////////////
+// List module //
+/////////////////
+
+class ModList: public Module {
+public:
+  ModList(): Module("List") {}
+
+  /**
+   * Stable sort of a list with a builtin comparator of the Value module
+   * Only `Value.'<'`, `'=<'`, `'>'` and `'>='` on lists of integers, floats,
+   * atoms, strings or byte strings are sorted natively. For anything else,
+   * `handled` is false and the caller falls back on its own merge sort.
+   */
+  class Sort: public Builtin<Sort> {
+  public:
+    Sort(): Builtin("sort") {}
+
+    static void call(VM vm, In list, In comparator, Out result, Out handled) {
+      bool descending = false;
+
+      if (!getBuiltinOrder(vm, comparator, descending)) {
+        result = build(vm, unit);
+        handled = build(vm, false);
+        return;
+      }
+
+      // Check the list before allocating anything, as this may suspend
+      size_t count = 0;
+      ElementKind kind = ElementKind::none;
+
+      ozListForEach(vm, list,
+        [vm, &count, &kind] (RichNode element) {
+          if (element.isTransient())
+            waitFor(vm, element);
+          kind = (count == 0) ? kindOf(element) :
+            mergeKinds(kind, kindOf(element));
+          count++;
+        },
+        "list"
+      );
+
+      if (count == 0) {
+        result = build(vm, vm->coreatoms.nil);
+        handled = build(vm, true);
+        return;
+      }
+
+      switch (kind) {
+        case ElementKind::smallInt:
+        case ElementKind::floatingPoint:
+        case ElementKind::atom:
+        case ElementKind::integer:
+        case ElementKind::string:
+        case ElementKind::byteString:
+          break;
+
+        default:
+          // Mixed or non-comparable elements, or NaNs
+          result = build(vm, unit);
+          handled = build(vm, false);
+          return;
+      }
+
+      // Nothing can raise nor suspend from here on
+      result = sortElements(vm, list, count, kind, descending);
+      handled = build(vm, true);
+    }
+  };
+
+private:
+  enum class ElementKind {
+    none, smallInt, integer, floatingPoint, atom, string, byteString
+  };
+
+  /** Sort a determined list of `count` elements of a sortable `kind` */
+  static UnstableNode sortElements(VM vm, RichNode list, size_t count,
+                                   ElementKind kind, bool descending) {
+    std::vector<RichNode> elements;
+    elements.reserve(count);
+
+    ozListForEach(vm, list,
+      [&elements] (RichNode element) {
+        elements.push_back(element);
+      },
+      "list"
+    );
+
+    switch (kind) {
+      case ElementKind::smallInt:
+        sortByKey<nativeint>(vm, elements, descending,
+          [] (RichNode element) { return element.as<SmallInt>().value(); },
+          std::less<nativeint>());
+        break;
+
+      case ElementKind::floatingPoint:
+        sortByKey<double>(vm, elements, descending,
+          [] (RichNode element) { return element.as<Float>().value(); },
+          std::less<double>());
+        break;
+
+      case ElementKind::atom:
+        sortByKey<atom_t>(vm, elements, descending,
+          [] (RichNode element) { return element.as<Atom>().value(); },
+          [] (atom_t lhs, atom_t rhs) { return lhs.compare(rhs) < 0; });
+        break;
+
+      default: // integers, strings and byte strings
+        std::stable_sort(elements.begin(), elements.end(),
+          [vm, descending] (RichNode lhs, RichNode rhs) -> bool {
+            int comparison = Comparable(lhs).compare(vm, rhs);
+            return descending ? (comparison > 0) : (comparison < 0);
+          }
+        );
+        break;
+    }
+
+    return buildListDynamic(vm, elements.size(), elements.data());
+  }
+
+  /**
+   * Whether `comparator` is one of the ordering builtins of the Value module
+   * '<' and '=<' sort in ascending order and '>' and '>=' in descending
+   * order. All of them yield the same list on natively comparable values.
+   */
+  static bool getBuiltinOrder(VM vm, RichNode comparator, bool& descending) {
+    if (!comparator.is<BuiltinProcedure>())
+      return false;
+
+    auto builtin = comparator.as<BuiltinProcedure>().value();
+    if (builtin->getModuleName() != "Value")
+      return false;
+
+    auto& name = builtin->getName();
+    if ((name == "<") || (name == "=<")) {
+      descending = false;
+      return true;
+    } else if ((name == ">") || (name == ">=")) {
+      descending = true;
+      return true;
+    } else {
+      return false;
+    }
+  }
+
+  static ElementKind kindOf(RichNode element) {
+    if (element.is<SmallInt>())
+      return ElementKind::smallInt;
+    else if (element.is<BigInt>())
+      return ElementKind::integer;
+    else if (element.is<Float>() && !std::isnan(element.as<Float>().value()))
+      return ElementKind::floatingPoint;
+    else if (element.is<Atom>())
+      return ElementKind::atom;
+    else if (element.is<String>())
+      return ElementKind::string;
+    else if (element.is<ByteString>())
+      return ElementKind::byteString;
+    else
+      return ElementKind::none;
+  }
+
+  static ElementKind mergeKinds(ElementKind left, ElementKind right) {
+    if (left == right)
+      return left;
+
+    bool leftInteger = (left == ElementKind::smallInt) ||
+      (left == ElementKind::integer);
+    bool rightInteger = (right == ElementKind::smallInt) ||
+      (right == ElementKind::integer);
+
+    if (leftInteger && rightInteger)
+      return ElementKind::integer;
+    else
+      return ElementKind::none;
+  }
+
+  /** Stable sort of `elements` on keys extracted once per element */
+  template <class Key, class GetKey, class Less>
+  static void sortByKey(VM vm, std::vector<RichNode>& elements,
+                        bool descending, const GetKey& getKey,
+                        const Less& less) {
+    typedef std::pair<Key, RichNode> Entry;
+
+    std::vector<Entry> entries;
+    entries.reserve(elements.size());
+    for (auto& element : elements)
+      entries.push_back(Entry(getKey(element), element));
+
+    if (descending) {
+      std::stable_sort(entries.begin(), entries.end(),
+        [&less] (const Entry& lhs, const Entry& rhs) -> bool {
+          return less(rhs.first, lhs.first);
+        }
+      );
+    } else {
+      std::stable_sort(entries.begin(), entries.end(),
+        [&less] (const Entry& lhs, const Entry& rhs) -> bool {
+          return less(lhs.first, rhs.first);
+        }
+      );
+    }
+
+    for (size_t i = 0; i < entries.size(); i++)
+      elements[i] = entries[i].second;
+  }
+};
+
+}
+
+}
+
+#endif // MOZART_GENERATOR
+
+#endif // MOZART_MODLIST_H
@@ -59,7 +59,8 @@ public:
     }
   };
 
-  class Add: public Builtin<Add>, public InlineAs<OpInlineAdd> {
+  class Add: public Builtin<Add>, public InlineAs<OpInlineAdd>,
+    NoAutoInline {
   public:
     Add(): Builtin("+") {}
 
@@ -68,7 +69,8 @@ public:
     }
   };
 
-  class Subtract: public Builtin<Subtract>, public InlineAs<OpInlineSubtract> {
+  class Subtract: public Builtin<Subtract>, public InlineAs<OpInlineSubtract>,
+    NoAutoInline {
   public:
     Subtract(): Builtin("-") {}
 
@@ -62,15 +62,22 @@ public:
     Unpack(): Builtin("unpack") {}
 
     static void call(VM vm, In vbs, Out result) {
-      // VBS to vector<unsigned char>
       size_t bufSize = ozVBSLengthForBuffer(vm, vbs);
-      std::vector<unsigned char> buffer;
-      ozVBSGet(vm, vbs, bufSize, buffer);
+      bool success;
 
-      // unpickle
-      std::string str(buffer.begin(), buffer.end());
-      std::istringstream input(str);
-      result = unpickle(vm, input);
+      {
+        // VBS to vector<unsigned char>
+        std::vector<unsigned char> buffer;
+        ozVBSGet(vm, vbs, bufSize, buffer);
+
+        // unpickle
+        std::string str(buffer.begin(), buffer.end());
+        std::istringstream input(str);
+        success = tryUnpickle(vm, input, result);
+      }
+
+      if (!success)
+        raiseMalformedPickle(vm);
     }
   };
 
@@ -94,11 +101,18 @@ public:
 
     static void call(VM vm, In fileNameVS, Out result) {
       size_t fileNameSize = ozVSLengthForBuffer(vm, fileNameVS);
-      std::string fileName;
-      ozVSGet(vm, fileNameVS, fileNameSize, fileName);
+      bool success;
+
+      {
+        std::string fileName;
+        ozVSGet(vm, fileNameVS, fileNameSize, fileName);
+
+        std::ifstream file(fileName, std::ios_base::binary);
+        success = tryUnpickle(vm, file, result);
+      }
 
-      std::ifstream file(fileName, std::ios_base::binary);
-      result = unpickle(vm, file);
+      if (!success)
+        raiseMalformedPickle(vm);
     }
   };
 };
@@ -0,0 +1,182 @@
+// Copyright © 2014, Université catholique de Louvain
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// *  Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// *  Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef MOZART_MODPROFILE_H
+#define MOZART_MODPROFILE_H
+
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+#include "../mozartcore.hh"
+
+#ifndef MOZART_GENERATOR
+
+namespace mozart {
+
+namespace builtins {
+
+////////////////////
+// Profile module //
+////////////////////
+
+class ModProfile: public Module {
+public:
+  ModProfile(): Module("Profile") {}
+
+  class Start: public Builtin<Start> {
+  public:
+    Start(): Builtin("start") {}
+
+    static void call(VM vm, In interval) {
+      auto intInterval = getArgument<nativeint>(vm, interval, "integer");
+      vm->getProfiler().start(intInterval);
+    }
+  };
+
+  class Stop: public Builtin<Stop> {
+  public:
+    Stop(): Builtin("stop") {}
+
+    static void call(VM vm) {
+      vm->getProfiler().stop();
+    }
+  };
+
+  class Reset: public Builtin<Reset> {
+  public:
+    Reset(): Builtin("reset") {}
+
+    static void call(VM vm) {
+      vm->getProfiler().reset();
+    }
+  };
+
+  class IsRunning: public Builtin<IsRunning> {
+  public:
+    IsRunning(): Builtin("isRunning") {}
+
+    static void call(VM vm, Out result) {
+      result = build(vm, vm->getProfiler().isEnabled());
+    }
+  };
+
+  class SampleCount: public Builtin<SampleCount> {
+  public:
+    SampleCount(): Builtin("sampleCount") {}
+
+    static void call(VM vm, Out result) {
+      result = build(vm, vm->getProfiler().getSampleCount());
+    }
+  };
+
+  class Collapsed: public Builtin<Collapsed> {
+  public:
+    Collapsed(): Builtin("collapsed") {}
+
+    static void call(VM vm, Out result) {
+      std::ostringstream buffer;
+      vm->getProfiler().dumpCollapsed(buffer);
+      result = String::build(vm, newLString(vm, buffer.str()));
+    }
+  };
+
+  class StartAllocations: public Builtin<StartAllocations> {
+  public:
+    StartAllocations(): Builtin("startAllocations") {}
+
+    static void call(VM vm, In sampleInterval) {
+      auto intSampleInterval = getArgument<nativeint>(vm, sampleInterval,
+                                                      "integer");
+      vm->getHeapProfiler().startAllocations(
+        intSampleInterval > 0 ? intSampleInterval : 1);
+    }
+  };
+
+  class StopAllocations: public Builtin<StopAllocations> {
+  public:
+    StopAllocations(): Builtin("stopAllocations") {}
+
+    static void call(VM vm) {
+      vm->getHeapProfiler().stopAllocations();
+    }
+  };
+
+  class SetCensus: public Builtin<SetCensus> {
+  public:
+    SetCensus(): Builtin("setCensus") {}
+
+    static void call(VM vm, In enabled) {
+      auto boolEnabled = getArgument<bool>(vm, enabled, "Boolean");
+      vm->getHeapProfiler().setCensusEnabled(boolEnabled);
+    }
+  };
+
+  class ResetHeap: public Builtin<ResetHeap> {
+  public:
+    ResetHeap(): Builtin("resetHeap") {}
+
+    static void call(VM vm) {
+      vm->getHeapProfiler().reset();
+    }
+  };
+
+  class GetHeap: public Builtin<GetHeap> {
+  public:
+    GetHeap(): Builtin("getHeap") {}
+
+    static void call(VM vm, Out result) {
+      result = vm->getHeapProfiler().buildProfileRecord(vm);
+    }
+  };
+
+  class DumpHeap: public Builtin<DumpHeap> {
+  public:
+    DumpHeap(): Builtin("dumpHeap") {}
+
+    static void call(VM vm, In fileNameVS) {
+      size_t fileNameSize = ozVSLengthForBuffer(vm, fileNameVS);
+      std::string fileName;
+      ozVSGet(vm, fileNameVS, fileNameSize, fileName);
+
+      std::ofstream file(fileName);
+      if (!file) {
+        int errnum = errno;
+        raiseSystem(vm, "os", "os", "open", (nativeint) errnum,
+                    vm->getAtom(std::strerror(errnum)));
+      }
+
+      vm->getHeapProfiler().dump(vm, file);
+    }
+  };
+};
+
+}
+
+}
+
+#endif // MOZART_GENERATOR
+
+#endif // MOZART_MODPROFILE_H
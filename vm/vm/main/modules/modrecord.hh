@@ -238,6 +238,197 @@ public:
       success = build(vm, true);
     }
   };
+
+  class Adjoin: public Builtin<Adjoin> {
+  public:
+    Adjoin(): Builtin("adjoin") {}
+
+    static void call(VM vm, In record1, In record2, Out result) {
+      RecordFields fields1(vm, record1);
+      RecordFields fields2(vm, record2);
+      auto label = RecordLike(record2).label(vm);
+
+      // Both arities are sorted, so a single merge pass yields the result
+      size_t capacity = fields1.width + fields2.width;
+      auto elements = vm->newStaticArray<UnstableField>(capacity);
+      size_t width = mergeFields(vm, fields1, fields2, elements);
+
+      result = buildRecordDynamicSorted(vm, label, width, elements);
+
+      vm->deleteStaticArray(elements, capacity);
+    }
+  };
+
+  class AdjoinList: public Builtin<AdjoinList> {
+  public:
+    AdjoinList(): Builtin("adjoinList") {}
+
+    static void call(VM vm, In record, In pairs, Out result) {
+      RecordFields fields(vm, record);
+      auto label = RecordLike(record).label(vm);
+
+      // Check the pairs before allocating anything, as this may suspend
+      size_t pairCount = 0;
+      ozListForEach(vm, pairs,
+        [vm, &pairCount] (RichNode pair) {
+          auto feature = Dottable(pair).dot(vm, 1);
+          requireFeature(vm, feature);
+          Dottable(pair).dot(vm, 2);
+          pairCount++;
+        },
+        "list"
+      );
+
+      // Gather the pairs, sort them, and let the last one of a feature win
+      auto pairFields = vm->newStaticArray<UnstableField>(pairCount);
+
+      ozListForEach(vm, pairs,
+        [vm, &pairFields] (RichNode pair, size_t i) {
+          pairFields[i].feature.init(vm, Dottable(pair).dot(vm, 1));
+          pairFields[i].value.init(vm, Dottable(pair).dot(vm, 2));
+        },
+        "list"
+      );
+
+      std::stable_sort((UnstableField*) pairFields,
+                       (UnstableField*) pairFields + pairCount,
+        [vm] (const UnstableField& lhs, const UnstableField& rhs) -> bool {
+          return compareFeatures(vm, internal::featureOf(lhs),
+                                 internal::featureOf(rhs)) < 0;
+        }
+      );
+
+      size_t uniqueCount = 0;
+      for (size_t i = 0; i < pairCount; i++) {
+        if ((i+1 < pairCount) &&
+            (compareFeatures(vm, pairFields[i].feature,
+                             pairFields[i+1].feature) == 0))
+          continue;
+
+        if (uniqueCount != i) {
+          pairFields[uniqueCount].feature = std::move(pairFields[i].feature);
+          pairFields[uniqueCount].value = std::move(pairFields[i].value);
+        }
+        uniqueCount++;
+      }
+
+      // Then merge them with the fields of the record in one pass
+      size_t capacity = fields.width + uniqueCount;
+      auto elements = vm->newStaticArray<UnstableField>(capacity);
+      size_t width = mergeFields(
+        vm, fields, RecordFields(pairFields, uniqueCount), elements);
+
+      result = buildRecordDynamicSorted(vm, label, width, elements);
+
+      vm->deleteStaticArray(elements, capacity);
+      vm->deleteStaticArray(pairFields, pairCount);
+    }
+  };
+
+  class Values: public Builtin<Values> {
+  public:
+    Values(): Builtin("values") {}
+
+    static void call(VM vm, In record, Out result) {
+      RecordFields fields(vm, record);
+      auto label = build(vm, vm->coreatoms.sharp);
+
+      result = buildTupleDynamic(vm, label, fields.width,
+                                 (StableNode*) fields.values);
+    }
+  };
+
+private:
+  /**
+   * Sorted view of the fields of a record, a tuple or a list of fields
+   * Features come from `arity` when it is not null, from `sortedFields` when
+   * it is not null, and are the integers 1 to width otherwise.
+   */
+  struct RecordFields {
+    RecordFields(VM vm, RichNode record):
+      width(0), values(nullptr, 0), arity(nullptr), sortedFields(nullptr) {
+
+      if (record.is<Tuple>()) {
+        auto tuple = record.as<Tuple>();
+        width = tuple.getWidth();
+        values = tuple.getElementsArray();
+      } else if (record.is<Cons>()) {
+        width = 2;
+        values = record.as<Cons>().getElementsArray();
+      } else if (record.is<Record>()) {
+        auto rec = record.as<Record>();
+        width = rec.getWidth();
+        values = rec.getElementsArray();
+        arity = rec.getArity();
+      } else if (!RecordLike(record).isRecord(vm)) {
+        raiseTypeError(vm, "record", record);
+      }
+    }
+
+    RecordFields(StaticArray<UnstableField> sortedFields, size_t width):
+      width(width), values(nullptr, 0), arity(nullptr),
+      sortedFields(sortedFields) {}
+
+    UnstableNode feature(VM vm, size_t index) {
+      if (sortedFields != nullptr)
+        return { vm, sortedFields[index].feature };
+      else if (arity != nullptr)
+        return { vm, *RichNode(*arity).as<mozart::Arity>().getElement(index) };
+      else
+        return build(vm, (nativeint) index + 1);
+    }
+
+    UnstableNode value(VM vm, size_t index) {
+      if (sortedFields != nullptr)
+        return { vm, sortedFields[index].value };
+      else
+        return { vm, values[index] };
+    }
+
+    size_t width;
+    StaticArray<StableNode> values;
+    StableNode* arity;
+    UnstableField* sortedFields;
+  };
+
+  /**
+   * Merge the fields of two records into `dest`, sorted by feature
+   * Fields of `right` win over fields of `left` with the same feature.
+   * Returns the number of fields written.
+   */
+  static size_t mergeFields(VM vm, RecordFields left, RecordFields right,
+                            StaticArray<UnstableField> dest) {
+    size_t i = 0, j = 0, k = 0;
+
+    while ((i < left.width) && (j < right.width)) {
+      auto leftFeature = left.feature(vm, i);
+      auto rightFeature = right.feature(vm, j);
+      int comparison = compareFeatures(vm, leftFeature, rightFeature);
+
+      if (comparison < 0) {
+        dest[k].feature.init(vm, std::move(leftFeature));
+        dest[k].value.init(vm, left.value(vm, i++));
+      } else {
+        dest[k].feature.init(vm, std::move(rightFeature));
+        dest[k].value.init(vm, right.value(vm, j++));
+        if (comparison == 0)
+          i++;
+      }
+      k++;
+    }
+
+    for (; i < left.width; i++, k++) {
+      dest[k].feature.init(vm, left.feature(vm, i));
+      dest[k].value.init(vm, left.value(vm, i));
+    }
+
+    for (; j < right.width; j++, k++) {
+      dest[k].feature.init(vm, right.feature(vm, j));
+      dest[k].value.init(vm, right.value(vm, j));
+    }
+
+    return k;
+  }
 };
 
 }
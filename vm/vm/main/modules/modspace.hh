@@ -111,6 +111,15 @@ public:
     }
   };
 
+  class Inject: public Builtin<Inject> {
+  public:
+    Inject(): Builtin("inject") {}
+
+    static void call(VM vm, In space, In callable) {
+      return SpaceLike(space).injectSpace(vm, callable);
+    }
+  };
+
   class Kill: public Builtin<Kill> {
   public:
     Kill(): Builtin("kill") {}
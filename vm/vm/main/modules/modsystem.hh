@@ -76,6 +76,20 @@ public:
       auto intDepth = getArgument<nativeint>(vm, depth);
       auto intWidth = getArgument<nativeint>(vm, width);
 
+      // Numbers are the most common, and need neither a stream nor recoding
+      char numberBuffer[NumberFormatBufferSize];
+      if (value.is<SmallInt>()) {
+        auto length = formatInt(numberBuffer, value.as<SmallInt>().value(),
+                                '~');
+        result = Atom::build(vm, length, numberBuffer);
+        return;
+      } else if (value.is<Float>()) {
+        auto length = formatFloat(numberBuffer, value.as<Float>().value(),
+                                  '~');
+        result = Atom::build(vm, length, numberBuffer);
+        return;
+      }
+
       auto& config = vm->getPropertyRegistry().config;
       if (intDepth <= 0)
         intDepth = config.printDepth;
@@ -28,7 +28,8 @@
 #include "../mozartcore.hh"
 
 #include <sstream>
-#include <cstdlib>
+#include <string>
+#include <vector>
 
 #ifndef MOZART_GENERATOR
 
@@ -131,28 +132,159 @@ public:
     }
   };
 
-  class ToFloat : public Builtin<ToFloat> {
+private:
+  static const size_t ShortNumberLength = 64;
+
+  /**
+   * Apply f to the chars of value, which should be a number
+   * Atoms and compact strings are read in place and short lists are copied
+   * on the stack, so that no allocation is made in the common cases.
+   */
+  template <class F>
+  static bool withNumberChars(VM vm, RichNode value, size_t bufSize,
+                              const F& f) {
+    using namespace patternmatching;
+
+    atom_t atomValue;
+    if (matches(vm, value, capture(atomValue))) {
+      if (atomValue == vm->coreatoms.nil)
+        return f(atomValue.contents(), atomValue.contents());
+      return f(atomValue.contents(),
+               atomValue.contents() + atomValue.length());
+    }
+
+    if (value.is<String>()) {
+      auto& str = value.as<String>().value();
+      return f(str.string, str.string + str.length);
+    }
+
+    if (value.is<Cons>()) {
+      char buffer[ShortNumberLength];
+      size_t length = 0;
+      bool isShortASCII = true;
+
+      internal::ozListForEachNoRaise(vm, value,
+        [&buffer, &length, &isShortASCII] (char32_t c) {
+          if (c < 128 && length < ShortNumberLength)
+            buffer[length++] = (char) c;
+          else
+            isShortASCII = false;
+        }
+      );
+
+      if (isShortASCII)
+        return f(buffer, buffer + length);
+    }
+
+    std::vector<char> buffer;
+    ozVSGet(vm, value, bufSize, buffer);
+    return f(buffer.data(), buffer.data() + buffer.size());
+  }
+
+  /**
+   * Parse an integer with the syntax of String.toInt
+   * Any number of alternating signs, '~' or '-', are followed by a decimal
+   * integer, or a hexadecimal (0x), binary (0b) or octal (0) one.
+   */
+  static bool stringToInt(VM vm, const char* begin, const char* end,
+                          UnstableNode& result) {
+    bool negative = false;
+    while ((begin != end) && ((*begin == '~') || (*begin == '-'))) {
+      if ((begin+1 != end) && (begin[1] == begin[0]))
+        return false;
+      negative = !negative;
+      ++begin;
+    }
+
+    int base = 10;
+    if ((end - begin >= 2) && (begin[0] == '0')) {
+      if ((begin[1] == 'x') || (begin[1] == 'X')) {
+        base = 16;
+        begin += 2;
+      } else if ((begin[1] == 'b') || (begin[1] == 'B')) {
+        base = 2;
+        begin += 2;
+      } else {
+        base = 8;
+        begin += 1;
+      }
+    }
+
+    // parseInt() would accept a sign after the base prefix
+    if ((begin == end) || (*begin == '~') || (*begin == '-'))
+      return false;
+
+    nativeint intValue;
+    switch (parseInt(begin, end, intValue, base)) {
+      case ParseIntResult::success:
+        result = build(vm, negative ? -intValue : intValue);
+        return true;
+
+      case ParseIntResult::overflow:
+        result = bigIntFromDigits(vm, begin, end, base, negative);
+        return true;
+
+      default:
+        return false;
+    }
+  }
+
+  static UnstableNode bigIntFromDigits(VM vm, const char* begin,
+                                       const char* end, int base,
+                                       bool negative) {
+    if (base == 10) {
+      std::string digits;
+      if (negative)
+        digits.push_back('-');
+      digits.append(begin, end);
+      return BigInt::build(vm, digits);
+    }
+
+    UnstableNode baseNode = build(vm, base);
+    UnstableNode acc = build(vm, 0);
+    for (const char* iter = begin; iter != end; ++iter) {
+      char c = *iter;
+      nativeint digit = (c <= '9') ? (c - '0') : ((c | 0x20) - 'a' + 10);
+      acc = Numeric(acc).multiply(vm, baseNode);
+      acc = Numeric(acc).add(vm, digit);
+    }
+
+    if (negative)
+      return Numeric(acc).opposite(vm);
+    return acc;
+  }
+public:
+  class ToInt : public Builtin<ToInt> {
   public:
-    ToFloat() : Builtin("toFloat") {}
+    ToInt() : Builtin("toInt") {}
 
     static void call(VM vm, In value, Out result) {
       size_t bufSize = ozVSLengthForBuffer(vm, value);
 
-      bool success;
-      double doubleResult;
+      bool success = withNumberChars(vm, value, bufSize,
+        [vm, &result] (const char* begin, const char* end) -> bool {
+          return stringToInt(vm, begin, end, result);
+        }
+      );
 
-      {
-        std::string str;
-        ozVSGet(vm, value, bufSize, str);
+      if (!success)
+        raiseKernelError(vm, "stringNoInt", value);
+    }
+  };
 
-        for (auto iter = str.begin(); iter != str.end(); ++iter)
-          if (*iter == '~')
-            *iter = '-';
+  class ToFloat : public Builtin<ToFloat> {
+  public:
+    ToFloat() : Builtin("toFloat") {}
 
-        char* end = nullptr;
-        doubleResult = std::strtod(str.c_str(), &end);
-        success = *end == '\0';
-      }
+    static void call(VM vm, In value, Out result) {
+      size_t bufSize = ozVSLengthForBuffer(vm, value);
+
+      double doubleResult;
+      bool success = withNumberChars(vm, value, bufSize,
+        [&doubleResult] (const char* begin, const char* end) -> bool {
+          return parseFloat(begin, end, doubleResult);
+        }
+      );
 
       if (!success)
         raiseKernelError(vm, "stringNoFloat", value);
@@ -0,0 +1,200 @@
+// Copyright © 2014, Université catholique de Louvain
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// *  Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// *  Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef MOZART_MODWEAKDICT_H
+#define MOZART_MODWEAKDICT_H
+
+#include "../mozartcore.hh"
+
+#ifndef MOZART_GENERATOR
+
+namespace mozart {
+
+namespace builtins {
+
+///////////////////////////
+// WeakDictionary module //
+///////////////////////////
+
+class ModWeakDictionary: public Module {
+public:
+  ModWeakDictionary(): Module("WeakDictionary") {}
+
+  class New: public Builtin<New> {
+  public:
+    New(): Builtin("new") {}
+
+    static void call(VM vm, Out stream, Out result) {
+      result = WeakDictionary::build(vm, stream);
+    }
+  };
+
+  class Is: public Builtin<Is> {
+  public:
+    Is(): Builtin("is") {}
+
+    static void call(VM vm, In value, Out result) {
+      if (value.isTransient())
+        waitFor(vm, value);
+      result = build(vm, value.is<WeakDictionary>());
+    }
+  };
+
+  class IsEmpty: public Builtin<IsEmpty> {
+  public:
+    IsEmpty(): Builtin("isEmpty") {}
+
+    static void call(VM vm, In dict, Out result) {
+      result = build(vm, getWeakDictionary(vm, dict).isEmpty(vm));
+    }
+  };
+
+  class Member: public Builtin<Member> {
+  public:
+    Member(): Builtin("member") {}
+
+    static void call(VM vm, In dict, In feature, Out result) {
+      result = build(vm, getWeakDictionary(vm, dict).member(vm, feature));
+    }
+  };
+
+  class Get: public Builtin<Get> {
+  public:
+    Get(): Builtin("get") {}
+
+    static void call(VM vm, In dict, In feature, Out result) {
+      result = getWeakDictionary(vm, dict).get(vm, feature);
+    }
+  };
+
+  class CondGet: public Builtin<CondGet> {
+  public:
+    CondGet(): Builtin("condGet") {}
+
+    static void call(VM vm, In dict, In feature, In defaultValue, Out result) {
+      result = getWeakDictionary(vm, dict).condGet(vm, feature, defaultValue);
+    }
+  };
+
+  class Put: public Builtin<Put> {
+  public:
+    Put(): Builtin("put") {}
+
+    static void call(VM vm, In dict, In feature, In newValue) {
+      getWeakDictionary(vm, dict).put(vm, feature, newValue);
+    }
+  };
+
+  class ExchangeFun: public Builtin<ExchangeFun> {
+  public:
+    ExchangeFun(): Builtin("exchangeFun") {}
+
+    static void call(VM vm, In dict, In feature, In newValue, Out oldValue) {
+      oldValue = getWeakDictionary(vm, dict).exchange(vm, feature, newValue);
+    }
+  };
+
+  class CondExchangeFun: public Builtin<CondExchangeFun> {
+  public:
+    CondExchangeFun(): Builtin("condExchangeFun") {}
+
+    static void call(VM vm, In dict, In feature, In defaultValue,
+                     In newValue, Out oldValue) {
+      oldValue = getWeakDictionary(vm, dict).condExchange(
+        vm, feature, defaultValue, newValue);
+    }
+  };
+
+  class Remove: public Builtin<Remove> {
+  public:
+    Remove(): Builtin("remove") {}
+
+    static void call(VM vm, In dict, In feature) {
+      getWeakDictionary(vm, dict).remove(vm, feature);
+    }
+  };
+
+  class RemoveAll: public Builtin<RemoveAll> {
+  public:
+    RemoveAll(): Builtin("removeAll") {}
+
+    static void call(VM vm, In dict) {
+      getWeakDictionary(vm, dict).removeAll(vm);
+    }
+  };
+
+  class Keys: public Builtin<Keys> {
+  public:
+    Keys(): Builtin("keys") {}
+
+    static void call(VM vm, In dict, Out result) {
+      result = getWeakDictionary(vm, dict).keys(vm);
+    }
+  };
+
+  class Entries: public Builtin<Entries> {
+  public:
+    Entries(): Builtin("entries") {}
+
+    static void call(VM vm, In dict, Out result) {
+      result = getWeakDictionary(vm, dict).entries(vm);
+    }
+  };
+
+  class Items: public Builtin<Items> {
+  public:
+    Items(): Builtin("items") {}
+
+    static void call(VM vm, In dict, Out result) {
+      result = getWeakDictionary(vm, dict).items(vm);
+    }
+  };
+
+  class Close: public Builtin<Close> {
+  public:
+    Close(): Builtin("close") {}
+
+    static void call(VM vm, In dict) {
+      getWeakDictionary(vm, dict).close(vm);
+    }
+  };
+
+private:
+  static TypedRichNode<WeakDictionary> getWeakDictionary(VM vm, In value) {
+    if (value.is<WeakDictionary>())
+      return value.as<WeakDictionary>();
+    else if (value.isTransient())
+      waitFor(vm, value);
+    else
+      raiseTypeError(vm, "WeakDictionary", value);
+  }
+};
+
+}
+
+}
+
+#endif // MOZART_GENERATOR
+
+#endif // MOZART_MODWEAKDICT_H
@@ -29,6 +29,7 @@
 
 #include "coredatatypes.hh"
 
+#include "alarms.hh"
 #include "builtins.hh"
 #include "coreatoms.hh"
 #include "datatype.hh"
@@ -36,9 +37,12 @@
 #include "exceptions.hh"
 #include "exchelpers.hh"
 #include "gcollect.hh"
+#include "heapprofiler.hh"
 #include "graphreplicator.hh"
 #include "lstring.hh"
+#include "numconv.hh"
 #include "ozcalls.hh"
+#include "profiler.hh"
 #include "properties.hh"
 #include "runnable.hh"
 #include "sclone.hh"
@@ -45,6 +45,7 @@
 #include "lstring-decl.hh"
 #include "coders-decl.hh"
 #include "utf-decl.hh"
+#include "numconv-decl.hh"
 #include "functiontraits-decl.hh"
 #include "vm-decl.hh"
 
@@ -0,0 +1,80 @@
+// Copyright © 2014, Université catholique de Louvain
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// *  Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// *  Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef MOZART_NUMCONV_DECL_H
+#define MOZART_NUMCONV_DECL_H
+
+#include "core-forward-decl.hh"
+
+namespace mozart {
+
+////////////////////////
+// Number conversions //
+////////////////////////
+
+/** Size of a buffer large enough for formatInt() and formatFloat() */
+constexpr size_t NumberFormatBufferSize = 32;
+
+/**
+ * Write the decimal representation of an integer to buffer
+ * The minus sign is given by `minus`, '-' or '~'.
+ * @return the number of chars written, without any trailing '\0'
+ */
+inline size_t formatInt(char* buffer, nativeint value, char minus = '-');
+
+/**
+ * Write the shortest representation of a float that reads back to the same
+ * float to buffer
+ * The representation always has a decimal point, and an exponent without
+ * '+' is used below 1e-4 and from 1e16 on. The minus sign, of the float as
+ * well as of the exponent, is given by `minus`, '-' or '~'.
+ * @return the number of chars written, without any trailing '\0'
+ */
+inline size_t formatFloat(char* buffer, double value, char minus = '-');
+
+enum class ParseIntResult {
+  success, overflow, invalid
+};
+
+/**
+ * Parse the integer in [begin, end), without allocating
+ * It is an optional minus sign, '-' or '~', followed by at least one digit
+ * in the given base (2 to 16). On overflow, result is left undefined.
+ */
+inline ParseIntResult parseInt(const char* begin, const char* end,
+                               nativeint& result, int base = 10);
+
+/**
+ * Parse the float in [begin, end), without allocating in most cases
+ * It is an optional minus sign, '-' or '~', digits with an optional decimal
+ * point, and an optional exponent with an optional sign, '-', '~' or '+'.
+ * Infinities and NaN are "inf" and "nan", as written by formatFloat(), or
+ * "Infinity" and "NaN", in any case and with an optional minus sign.
+ * @return whether the whole range is a float
+ */
+inline bool parseFloat(const char* begin, const char* end, double& result);
+
+}
+
+#endif // MOZART_NUMCONV_DECL_H
@@ -0,0 +1,639 @@
+// Copyright © 2014, Université catholique de Louvain
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// *  Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// *  Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef MOZART_NUMCONV_H
+#define MOZART_NUMCONV_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <type_traits>
+
+#include "mozartcore.hh"
+
+namespace mozart {
+
+////////////////////////
+// Number conversions //
+////////////////////////
+
+namespace internal {
+
+/**
+ * Shortest float representation with the Grisu2 algorithm of
+ * Florian Loitsch, "Printing Floating-Point Numbers Quickly and Accurately
+ * with Integers", PLDI 2010
+ * The digits it generates always read back to the same float, and they are
+ * the shortest ones for all but a tiny fraction of the floats.
+ */
+namespace grisu {
+
+struct DiyFp {
+  std::uint64_t f;
+  int e;
+};
+
+struct CachedPower {
+  std::uint64_t f;
+  int e;
+  int k;
+};
+
+// Bounds of the binary exponent of the scaled floats
+constexpr int Alpha = -60;
+constexpr int Gamma = -32;
+
+constexpr int CachedPowersMinDecExp = -300;
+constexpr int CachedPowersDecStep = 8;
+
+/** Normalized 10^k for k = -300, -292, ..., 324, rounded to nearest */
+inline
+const CachedPower& cachedPower(size_t index) {
+  static const CachedPower cachedPowers[] = {
+    { 0xAB70FE17C79AC6CAULL, -1060, -300 },
+    { 0xFF77B1FCBEBCDC4FULL, -1034, -292 },
+    { 0xBE5691EF416BD60CULL, -1007, -284 },
+    { 0x8DD01FAD907FFC3CULL,  -980, -276 },
+    { 0xD3515C2831559A83ULL,  -954, -268 },
+    { 0x9D71AC8FADA6C9B5ULL,  -927, -260 },
+    { 0xEA9C227723EE8BCBULL,  -901, -252 },
+    { 0xAECC49914078536DULL,  -874, -244 },
+    { 0x823C12795DB6CE57ULL,  -847, -236 },
+    { 0xC21094364DFB5637ULL,  -821, -228 },
+    { 0x9096EA6F3848984FULL,  -794, -220 },
+    { 0xD77485CB25823AC7ULL,  -768, -212 },
+    { 0xA086CFCD97BF97F4ULL,  -741, -204 },
+    { 0xEF340A98172AACE5ULL,  -715, -196 },
+    { 0xB23867FB2A35B28EULL,  -688, -188 },
+    { 0x84C8D4DFD2C63F3BULL,  -661, -180 },
+    { 0xC5DD44271AD3CDBAULL,  -635, -172 },
+    { 0x936B9FCEBB25C996ULL,  -608, -164 },
+    { 0xDBAC6C247D62A584ULL,  -582, -156 },
+    { 0xA3AB66580D5FDAF6ULL,  -555, -148 },
+    { 0xF3E2F893DEC3F126ULL,  -529, -140 },
+    { 0xB5B5ADA8AAFF80B8ULL,  -502, -132 },
+    { 0x87625F056C7C4A8BULL,  -475, -124 },
+    { 0xC9BCFF6034C13053ULL,  -449, -116 },
+    { 0x964E858C91BA2655ULL,  -422, -108 },
+    { 0xDFF9772470297EBDULL,  -396, -100 },
+    { 0xA6DFBD9FB8E5B88FULL,  -369,  -92 },
+    { 0xF8A95FCF88747D94ULL,  -343,  -84 },
+    { 0xB94470938FA89BCFULL,  -316,  -76 },
+    { 0x8A08F0F8BF0F156BULL,  -289,  -68 },
+    { 0xCDB02555653131B6ULL,  -263,  -60 },
+    { 0x993FE2C6D07B7FACULL,  -236,  -52 },
+    { 0xE45C10C42A2B3B06ULL,  -210,  -44 },
+    { 0xAA242499697392D3ULL,  -183,  -36 },
+    { 0xFD87B5F28300CA0EULL,  -157,  -28 },
+    { 0xBCE5086492111AEBULL,  -130,  -20 },
+    { 0x8CBCCC096F5088CCULL,  -103,  -12 },
+    { 0xD1B71758E219652CULL,   -77,   -4 },
+    { 0x9C40000000000000ULL,   -50,    4 },
+    { 0xE8D4A51000000000ULL,   -24,   12 },
+    { 0xAD78EBC5AC620000ULL,     3,   20 },
+    { 0x813F3978F8940984ULL,    30,   28 },
+    { 0xC097CE7BC90715B3ULL,    56,   36 },
+    { 0x8F7E32CE7BEA5C70ULL,    83,   44 },
+    { 0xD5D238A4ABE98068ULL,   109,   52 },
+    { 0x9F4F2726179A2245ULL,   136,   60 },
+    { 0xED63A231D4C4FB27ULL,   162,   68 },
+    { 0xB0DE65388CC8ADA8ULL,   189,   76 },
+    { 0x83C7088E1AAB65DBULL,   216,   84 },
+    { 0xC45D1DF942711D9AULL,   242,   92 },
+    { 0x924D692CA61BE758ULL,   269,  100 },
+    { 0xDA01EE641A708DEAULL,   295,  108 },
+    { 0xA26DA3999AEF774AULL,   322,  116 },
+    { 0xF209787BB47D6B85ULL,   348,  124 },
+    { 0xB454E4A179DD1877ULL,   375,  132 },
+    { 0x865B86925B9BC5C2ULL,   402,  140 },
+    { 0xC83553C5C8965D3DULL,   428,  148 },
+    { 0x952AB45CFA97A0B3ULL,   455,  156 },
+    { 0xDE469FBD99A05FE3ULL,   481,  164 },
+    { 0xA59BC234DB398C25ULL,   508,  172 },
+    { 0xF6C69A72A3989F5CULL,   534,  180 },
+    { 0xB7DCBF5354E9BECEULL,   561,  188 },
+    { 0x88FCF317F22241E2ULL,   588,  196 },
+    { 0xCC20CE9BD35C78A5ULL,   614,  204 },
+    { 0x98165AF37B2153DFULL,   641,  212 },
+    { 0xE2A0B5DC971F303AULL,   667,  220 },
+    { 0xA8D9D1535CE3B396ULL,   694,  228 },
+    { 0xFB9B7CD9A4A7443CULL,   720,  236 },
+    { 0xBB764C4CA7A44410ULL,   747,  244 },
+    { 0x8BAB8EEFB6409C1AULL,   774,  252 },
+    { 0xD01FEF10A657842CULL,   800,  260 },
+    { 0x9B10A4E5E9913129ULL,   827,  268 },
+    { 0xE7109BFBA19C0C9DULL,   853,  276 },
+    { 0xAC2820D9623BF429ULL,   880,  284 },
+    { 0x80444B5E7AA7CF85ULL,   907,  292 },
+    { 0xBF21E44003ACDD2DULL,   933,  300 },
+    { 0x8E679C2F5E44FF8FULL,   960,  308 },
+    { 0xD433179D9C8CB841ULL,   986,  316 },
+    { 0x9E19DB92B4E31BA9ULL,  1013,  324 },
+  };
+
+  return cachedPowers[index];
+}
+
+/** Upper 64 bits of the product, rounded */
+inline
+DiyFp multiply(DiyFp x, DiyFp y) {
+  const std::uint64_t mask = 0xFFFFFFFFu;
+
+  std::uint64_t a = x.f >> 32, b = x.f & mask;
+  std::uint64_t c = y.f >> 32, d = y.f & mask;
+
+  std::uint64_t ac = a * c, bc = b * c, ad = a * d, bd = b * d;
+  std::uint64_t middle = (bd >> 32) + (ad & mask) + (bc & mask);
+  middle += std::uint64_t(1) << 31;
+
+  return { ac + (ad >> 32) + (bc >> 32) + (middle >> 32), x.e + y.e + 64 };
+}
+
+inline
+DiyFp normalize(DiyFp x) {
+  while ((x.f >> 63) == 0) {
+    x.f <<= 1;
+    x.e--;
+  }
+  return x;
+}
+
+/** Find 10^k with Alpha <= e + (binary exponent of 10^k) + 64 <= Gamma */
+inline
+const CachedPower& cachedPowerForBinaryExponent(int e) {
+  // k = ceil((Alpha - e - 1) * log10(2))
+  int f = Alpha - e - 1;
+  int k = (f * 78913) / (1 << 18) + (f > 0 ? 1 : 0);
+
+  int index = (-CachedPowersMinDecExp + k + (CachedPowersDecStep - 1)) /
+    CachedPowersDecStep;
+  const CachedPower& result = cachedPower((size_t) index);
+  assert(Alpha <= result.e + e + 64 && result.e + e + 64 <= Gamma);
+  return result;
+}
+
+/** Number of decimal digits of n, and the largest power of 10 <= n */
+inline
+int largestPow10(std::uint32_t n, std::uint32_t& pow10) {
+  int digits = 1;
+  pow10 = 1;
+  while (digits < 10 && n / 10 >= pow10) {
+    pow10 *= 10;
+    digits++;
+  }
+  return digits;
+}
+
+inline
+void roundLastDigit(char* digits, int length, std::uint64_t dist, std::uint64_t delta,
+           std::uint64_t rest, std::uint64_t tenK) {
+  // Move the last digit down while it gets closer to the exact value
+  // and stays within the rounding interval
+  while ((rest < dist) && (delta - rest >= tenK) &&
+         ((rest + tenK < dist) || (dist - rest > rest + tenK - dist))) {
+    digits[length - 1]--;
+    rest += tenK;
+  }
+}
+
+/**
+ * Generate the digits of a float in (low, high), as close to w as possible
+ * low, w and high are scaled so that their exponent is in [Alpha, Gamma].
+ */
+inline
+void generateDigits(char* digits, int& length, int& decimalExponent,
+                    DiyFp low, DiyFp w, DiyFp high) {
+  std::uint64_t delta = high.f - low.f;
+  std::uint64_t dist = high.f - w.f;
+
+  // Split high into an integral part p1 and a fractional part p2
+  int shift = -high.e;
+  std::uint64_t one = std::uint64_t(1) << shift;
+  std::uint32_t p1 = (std::uint32_t) (high.f >> shift);
+  std::uint64_t p2 = high.f & (one - 1);
+
+  std::uint32_t pow10;
+  int n = largestPow10(p1, pow10);
+
+  length = 0;
+
+  while (n > 0) {
+    std::uint32_t digit = p1 / pow10;
+    p1 %= pow10;
+    digits[length++] = (char) ('0' + digit);
+    n--;
+
+    std::uint64_t rest = ((std::uint64_t) p1 << shift) + p2;
+    if (rest <= delta) {
+      decimalExponent += n;
+      roundLastDigit(digits, length, dist, delta, rest,
+            (std::uint64_t) pow10 << shift);
+      return;
+    }
+
+    pow10 /= 10;
+  }
+
+  int m = 0;
+  for (;;) {
+    p2 *= 10;
+    digits[length++] = (char) ('0' + (p2 >> shift));
+    p2 &= one - 1;
+    m++;
+
+    delta *= 10;
+    dist *= 10;
+    if (p2 <= delta)
+      break;
+  }
+
+  decimalExponent -= m;
+  roundLastDigit(digits, length, dist, delta, p2, one);
+}
+
+/**
+ * Shortest digits of a finite positive float
+ * value == digits * 10^decimalExponent
+ */
+inline
+void shortestDigits(char* digits, int& length, int& decimalExponent,
+                    double value) {
+  std::uint64_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+
+  std::uint64_t fraction = bits & ((std::uint64_t(1) << 52) - 1);
+  int biasedExponent = (int) (bits >> 52) & 0x7FF;
+
+  DiyFp v;
+  if (biasedExponent == 0)
+    v = { fraction, 1 - 1075 };
+  else
+    v = { fraction | (std::uint64_t(1) << 52), biasedExponent - 1075 };
+
+  // Boundaries of the values that round to v
+  DiyFp high = normalize({ (v.f << 1) + 1, v.e - 1 });
+  bool lowerIsCloser = (fraction == 0) && (biasedExponent > 1);
+  DiyFp low = lowerIsCloser ?
+    DiyFp { (v.f << 2) - 1, v.e - 2 } : DiyFp { (v.f << 1) - 1, v.e - 1 };
+  low = { low.f << (low.e - high.e), high.e };
+  DiyFp w = normalize(v);
+  w = { w.f << (w.e - high.e), high.e };
+
+  const CachedPower& cached = cachedPowerForBinaryExponent(high.e);
+  DiyFp c = { cached.f, cached.e };
+
+  DiyFp scaledW = multiply(w, c);
+  DiyFp scaledLow = multiply(low, c);
+  DiyFp scaledHigh = multiply(high, c);
+
+  // Stay inside the boundaries despite the errors of the multiplications
+  scaledLow.f++;
+  scaledHigh.f--;
+
+  decimalExponent = -cached.k;
+  generateDigits(digits, length, decimalExponent,
+                 scaledLow, scaledW, scaledHigh);
+}
+
+} // namespace grisu
+
+inline
+size_t formatExponent(char* buffer, int exponent, char minus) {
+  char* out = buffer;
+  if (exponent < 0) {
+    *out++ = minus;
+    exponent = -exponent;
+  }
+
+  if (exponent >= 100) {
+    *out++ = (char) ('0' + exponent / 100);
+    exponent %= 100;
+    *out++ = (char) ('0' + exponent / 10);
+    *out++ = (char) ('0' + exponent % 10);
+  } else if (exponent >= 10) {
+    *out++ = (char) ('0' + exponent / 10);
+    *out++ = (char) ('0' + exponent % 10);
+  } else {
+    *out++ = (char) ('0' + exponent);
+  }
+
+  return out - buffer;
+}
+
+inline
+int digitValue(char c) {
+  if (c >= '0' && c <= '9')
+    return c - '0';
+  else if (c >= 'a' && c <= 'f')
+    return c - 'a' + 10;
+  else if (c >= 'A' && c <= 'F')
+    return c - 'A' + 10;
+  else
+    return 99;
+}
+
+/** Whether [begin, end) is word, ignoring case. word must be lowercase. */
+inline
+bool matchesWord(const char* begin, const char* end, const char* word) {
+  size_t length = std::strlen(word);
+  if ((size_t) (end - begin) != length)
+    return false;
+
+  for (size_t i = 0; i < length; i++) {
+    char c = begin[i];
+    if (c >= 'A' && c <= 'Z')
+      c = (char) (c - 'A' + 'a');
+    if (c != word[i])
+      return false;
+  }
+
+  return true;
+}
+
+} // namespace internal
+
+size_t formatInt(char* buffer, nativeint value, char minus) {
+  char* out = buffer;
+
+  typedef std::make_unsigned<nativeint>::type unativeint;
+  unativeint magnitude = (unativeint) value;
+  if (value < 0) {
+    *out++ = minus;
+    magnitude = (unativeint) 0 - magnitude;
+  }
+
+  // Digits in reverse order, then reversed in place
+  char* digits = out;
+  do {
+    *out++ = (char) ('0' + magnitude % 10);
+    magnitude /= 10;
+  } while (magnitude != 0);
+  std::reverse(digits, out);
+
+  return out - buffer;
+}
+
+size_t formatFloat(char* buffer, double value, char minus) {
+  using namespace internal;
+
+  char* out = buffer;
+
+  if (std::isnan(value)) {
+    std::memcpy(out, "nan", 3);
+    return 3;
+  }
+
+  if (std::signbit(value)) {
+    *out++ = minus;
+    value = -value;
+  }
+
+  if (std::isinf(value)) {
+    std::memcpy(out, "inf", 3);
+    return (out + 3) - buffer;
+  }
+
+  if (value == 0.0) {
+    std::memcpy(out, "0.0", 3);
+    return (out + 3) - buffer;
+  }
+
+  char digits[20];
+  int length, decimalExponent;
+  grisu::shortestDigits(digits, length, decimalExponent, value);
+
+  // Position of the decimal point relative to the first digit
+  int point = length + decimalExponent;
+
+  if ((point > -4) && (point <= 16)) {
+    if (decimalExponent >= 0) {
+      // 1500.0
+      std::memcpy(out, digits, length);
+      out += length;
+      std::memset(out, '0', decimalExponent);
+      out += decimalExponent;
+      *out++ = '.';
+      *out++ = '0';
+    } else if (point > 0) {
+      // 12.34
+      std::memcpy(out, digits, point);
+      out += point;
+      *out++ = '.';
+      std::memcpy(out, digits + point, length - point);
+      out += length - point;
+    } else {
+      // 0.001234
+      *out++ = '0';
+      *out++ = '.';
+      std::memset(out, '0', -point);
+      out += -point;
+      std::memcpy(out, digits, length);
+      out += length;
+    }
+  } else {
+    // 1.234e56
+    *out++ = digits[0];
+    *out++ = '.';
+    if (length > 1) {
+      std::memcpy(out, digits + 1, length - 1);
+      out += length - 1;
+    } else {
+      *out++ = '0';
+    }
+    *out++ = 'e';
+    out += formatExponent(out, point - 1, minus);
+  }
+
+  return out - buffer;
+}
+
+ParseIntResult parseInt(const char* begin, const char* end,
+                        nativeint& result, int base) {
+  using namespace internal;
+
+  assert(base >= 2 && base <= 16);
+
+  bool negative = false;
+  if ((begin != end) && (*begin == '-' || *begin == '~')) {
+    negative = true;
+    ++begin;
+  }
+
+  if (begin == end)
+    return ParseIntResult::invalid;
+
+  typedef std::make_unsigned<nativeint>::type unativeint;
+  const unativeint limit = negative ?
+    (unativeint) std::numeric_limits<nativeint>::max() + 1 :
+    (unativeint) std::numeric_limits<nativeint>::max();
+
+  unativeint magnitude = 0;
+  bool overflow = false;
+
+  for (const char* iter = begin; iter != end; ++iter) {
+    int digit = digitValue(*iter);
+    if (digit >= base)
+      return ParseIntResult::invalid;
+
+    if (!overflow) {
+      if (magnitude > (limit - digit) / base)
+        overflow = true;
+      else
+        magnitude = magnitude * base + digit;
+    }
+  }
+
+  if (overflow)
+    return ParseIntResult::overflow;
+
+  result = negative ? (nativeint) ((unativeint) 0 - magnitude) :
+    (nativeint) magnitude;
+  return ParseIntResult::success;
+}
+
+bool parseFloat(const char* begin, const char* end, double& result) {
+  using namespace internal;
+
+  const char* iter = begin;
+
+  bool negative = false;
+  if ((iter != end) && (*iter == '-' || *iter == '~')) {
+    negative = true;
+    ++iter;
+  }
+
+  // "Infinity" and "NaN" are written by Double.toString in the bootcompiler
+  if (matchesWord(iter, end, "inf") || matchesWord(iter, end, "infinity")) {
+    result = negative ? -std::numeric_limits<double>::infinity() :
+      std::numeric_limits<double>::infinity();
+    return true;
+  } else if (matchesWord(iter, end, "nan")) {
+    result = std::numeric_limits<double>::quiet_NaN();
+    return true;
+  }
+
+  // Up to 19 significant digits fit in a 64-bit mantissa
+  std::uint64_t mantissa = 0;
+  int significantDigits = 0;
+  int exponent = 0;
+  bool truncated = false;
+  bool hasDigits = false;
+
+  for (; (iter != end) && (*iter >= '0') && (*iter <= '9'); ++iter) {
+    hasDigits = true;
+    if (significantDigits < 19) {
+      mantissa = mantissa * 10 + (*iter - '0');
+      if (mantissa != 0)
+        significantDigits++;
+    } else {
+      exponent++;
+      truncated |= (*iter != '0');
+    }
+  }
+
+  if ((iter != end) && (*iter == '.')) {
+    for (++iter; (iter != end) && (*iter >= '0') && (*iter <= '9'); ++iter) {
+      hasDigits = true;
+      if (significantDigits < 19) {
+        mantissa = mantissa * 10 + (*iter - '0');
+        if (mantissa != 0)
+          significantDigits++;
+        exponent--;
+      } else {
+        truncated |= (*iter != '0');
+      }
+    }
+  }
+
+  if (!hasDigits)
+    return false;
+
+  if ((iter != end) && (*iter == 'e' || *iter == 'E')) {
+    ++iter;
+
+    bool negativeExponent = false;
+    if ((iter != end) && (*iter == '-' || *iter == '~' || *iter == '+')) {
+      negativeExponent = (*iter != '+');
+      ++iter;
+    }
+
+    if ((iter == end) || (*iter < '0') || (*iter > '9'))
+      return false;
+
+    int explicitExponent = 0;
+    for (; (iter != end) && (*iter >= '0') && (*iter <= '9'); ++iter) {
+      // Larger exponents all give 0 or infinity anyway
+      if (explicitExponent < 100000)
+        explicitExponent = explicitExponent * 10 + (*iter - '0');
+    }
+
+    exponent += negativeExponent ? -explicitExponent : explicitExponent;
+  }
+
+  if (iter != end)
+    return false;
+
+  // Exact in double arithmetic: both operands are exactly representable
+  static const double exactPowersOf10[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+  };
+
+  if (mantissa == 0) {
+    result = negative ? -0.0 : 0.0;
+    return true;
+  } else if (!truncated && (mantissa <= (std::uint64_t(1) << 53)) &&
+             (exponent >= -22) && (exponent <= 22)) {
+    double value = (double) mantissa;
+    if (exponent >= 0)
+      value *= exactPowersOf10[exponent];
+    else
+      value /= exactPowersOf10[-exponent];
+    result = negative ? -value : value;
+    return true;
+  }
+
+  // Hard cases: let strtod round correctly, from a copy with '-' signs
+  const size_t length = end - begin;
+  char shortBuffer[64];
+  std::string longBuffer;
+  char* buffer = shortBuffer;
+  if (length >= sizeof(shortBuffer)) {
+    longBuffer.resize(length + 1);
+    buffer = &longBuffer[0];
+  }
+
+  for (size_t i = 0; i < length; i++)
+    buffer[i] = (begin[i] == '~') ? '-' : begin[i];
+  buffer[length] = '\0';
+
+  result = std::strtod(buffer, nullptr);
+  return true;
+}
+
+}
+
+#endif // MOZART_NUMCONV_H
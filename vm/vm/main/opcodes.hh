@@ -204,6 +204,43 @@ const OpCode OpLocalVarname = 0xa2;
 const OpCode OpGlobalVarname = 0xa3;
 const OpCode OpClearY = 0xa4;
 
+// Quickened opcodes
+// The emulator rewrites a generic opcode in place into one of these after
+// observing the types of its operands. A quickened opcode checks its
+// assumptions and rewrites itself to the matching polymorphic opcode when
+// they fail. Polymorphic opcodes behave as the generic ones but are never
+// quickened again, so that a site does not flip-flop between the two.
+// None of these is ever emitted by the compiler.
+
+const OpCode OpQuickAddInt = 0xb1;
+const OpCode OpQuickSubtractInt = 0xb2;
+const OpCode OpQuickPlus1Int = 0xb3;
+const OpCode OpQuickMinus1Int = 0xb4;
+const OpCode OpQuickUnifyXKAtom = 0xb8;
+const OpCode OpQuickCallBuiltinN = 0xb9;
+
+const OpCode OpPolyInlineAdd = 0xc1;
+const OpCode OpPolyInlineSubtract = 0xc2;
+const OpCode OpPolyInlinePlus1 = 0xc3;
+const OpCode OpPolyInlineMinus1 = 0xc4;
+const OpCode OpPolyUnifyXK = 0xc8;
+
+/**
+ * Generic opcode from which op was derived by quickening, or op itself
+ */
+inline
+OpCode genericOpCode(OpCode op) {
+  switch (op) {
+    case OpQuickAddInt: case OpPolyInlineAdd: return OpInlineAdd;
+    case OpQuickSubtractInt: case OpPolyInlineSubtract: return OpInlineSubtract;
+    case OpQuickPlus1Int: case OpPolyInlinePlus1: return OpInlinePlus1;
+    case OpQuickMinus1Int: case OpPolyInlineMinus1: return OpInlineMinus1;
+    case OpQuickUnifyXKAtom: case OpPolyUnifyXK: return OpUnifyXK;
+    case OpQuickCallBuiltinN: return OpCallBuiltinN;
+    default: return op;
+  }
+}
+
 }
 
 #endif // MOZART_OPCODES_H
@@ -72,21 +72,24 @@ static void restoreNodes(VM vm, VMAllocatedList<NodeBackup>& list) {
 }
 
 void Pickler::pickle(RichNode value, RichNode temporaryReplacement) {
+  prepare(value, temporaryReplacement);
+  write(*output);
+}
+
+void Pickler::prepare(RichNode value, RichNode temporaryReplacement) {
   auto typesRecord = RichNode(*vm->getPickleTypesRecord()).as<Record>();
   auto statelessTypes = RichNode(*typesRecord.getArity()).as<Arity>();
 
   SerializationCallback cb(vm);
-  UnstableNode topLevelIndex = OptVar::build(vm);
+  topLevelIndex = OptVar::build(vm);
   cb.copy(topLevelIndex, value);
 
   bool futures = false;
-  nativeint count = 0;
+  count = 0;
   VMAllocatedList<NodeBackup> nodeBackups;
-  VMAllocatedList<PickleNode> nodes;
   UnstableNode resources = buildNil(vm);
 
   // Apply temporary replacements.
-  VMAllocatedList<NodeBackup> nodeReplacementBackups;
   {
     VMAllocatedList<std::pair<RichNode, RichNode>> replacements;
 
@@ -171,6 +174,10 @@ void Pickler::pickle(RichNode value, RichNode temporaryReplacement) {
         buildSharp(vm, "Resources", resources),
         buildSharp(vm, "Filename", "UNKNOWN FILENAME")));
   }
+}
+
+void Pickler::write(std::ostream& output) {
+  this->output = &output;
 
   // header
   writeSize(count);
@@ -428,14 +435,14 @@ void Pickler::writeNode(nativeint index, RichNode node, RichNode refsTuple) {
 }
 
 void Pickler::writeByte(unsigned char byte) {
-  output.put(byte);
+  output->put(byte);
 }
 
 void Pickler::writeSize(size_t size) {
-  output.put(size >> 24 & 0xff);
-  output.put(size >> 16 & 0xff);
-  output.put(size >> 8 & 0xff);
-  output.put(size & 0xff);
+  output->put(size >> 24 & 0xff);
+  output->put(size >> 16 & 0xff);
+  output->put(size >> 8 & 0xff);
+  output->put(size & 0xff);
 }
 
 void Pickler::writeSize(RichNode size) {
@@ -444,7 +451,7 @@ void Pickler::writeSize(RichNode size) {
 
 void Pickler::writeStr(const char* str, size_t len) {
   writeSize(len);
-  output.write(str, len);
+  output->write(str, len);
 }
 
 void Pickler::writeAtom(RichNode atom) {
@@ -453,6 +460,18 @@ void Pickler::writeAtom(RichNode atom) {
 }
 
 void Pickler::writeAsVS(RichNode node) {
+  // Small numbers, by far the most common, are formatted on the stack
+  char numberBuffer[NumberFormatBufferSize];
+  if (node.is<SmallInt>()) {
+    writeStr(numberBuffer,
+             formatInt(numberBuffer, node.as<SmallInt>().value()));
+    return;
+  } else if (node.is<Float>()) {
+    writeStr(numberBuffer,
+             formatFloat(numberBuffer, node.as<Float>().value()));
+    return;
+  }
+
   size_t size = ozVSLengthForBuffer(vm, node);
   std::vector<char> buffer;
   ozVSGet(vm, node, size, buffer);
@@ -485,7 +504,7 @@ void Pickler::writeUUIDOf(RichNode node) {
   UUID uuid = node.type()->globalize(vm, node)->uuid;
   char buffer[UUID::byte_count];
   uuid.toBytes(reinterpret_cast<unsigned char*>(buffer));
-  output.write(buffer, UUID::byte_count);
+  output->write(buffer, UUID::byte_count);
 }
 
 } // namespace mozart
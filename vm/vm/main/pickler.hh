@@ -48,10 +48,24 @@ public:
 
 public:
   Pickler(VM vm, std::ostream& output):
-    vm(vm), output(output) {}
+    vm(vm), output(&output), count(0) {}
+
+  /** A pickler that can only write() to the output it is given later */
+  explicit Pickler(VM vm):
+    vm(vm), output(nullptr), count(0) {}
 
   void pickle(RichNode value, RichNode temporaryReplacement);
 
+  /**
+   * First step of pickle(): traverse the value, and wait on futures or raise
+   * on resources. Only VM memory is used, so that nothing leaks when this
+   * suspends or raises. It must be followed by write().
+   */
+  void prepare(RichNode value, RichNode temporaryReplacement);
+
+  /** Second step of pickle(), which does not raise */
+  void write(std::ostream& output);
+
 private:
   void writeValues(VMAllocatedList<PickleNode>& nodes);
   void writeArities(VMAllocatedList<PickleNode>& nodes);
@@ -84,8 +98,13 @@ private:
 
 private:
   VM vm;
-  std::ostream& output;
+  std::ostream* output;
   StaticArray<nativeint> redirections;
+
+  nativeint count;
+  UnstableNode topLevelIndex;
+  VMAllocatedList<PickleNode> nodes;
+  VMAllocatedList<NodeBackup> nodeReplacementBackups;
 };
 
 /////////////////
@@ -0,0 +1,109 @@
+// Copyright © 2014, Université catholique de Louvain
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// *  Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// *  Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef MOZART_PROFILER_DECL_H
+#define MOZART_PROFILER_DECL_H
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+
+#include "core-forward-decl.hh"
+
+namespace mozart {
+
+class ThreadStack;
+
+//////////////
+// Profiler //
+//////////////
+
+/**
+ * Sampling profiler for the Oz threads of a VM.
+ *
+ * A sample is taken when a thread is preempted, at most once per interval of
+ * reference time. Threads that suspend are not sampled, so that the samples
+ * measure running time rather than waiting time. The environment advances the reference time at each preemption tick,
+ * so testing whether a sample is due is a single comparison.
+ *
+ * A sample records the procedure and source line of the topmost MaxDepth
+ * frames of the thread. Samples are aggregated by stack and are exported in
+ * the collapsed stacks format of flame graphs: one line per distinct stack,
+ * outermost frame first, frames separated by ';', followed by the count.
+ *
+ * The profiler is only ever accessed by the VM thread.
+ */
+class Profiler {
+public:
+  static const size_t MaxDepth = 32;
+
+  Profiler(): _enabled(false), _interval(10), _nextSample(0),
+    _sampleCount(0) {}
+
+  bool isEnabled() {
+    return _enabled;
+  }
+
+  /** Start sampling, once every interval milliseconds */
+  void start(std::int64_t interval) {
+    _enabled = true;
+    _interval = interval > 0 ? interval : 1;
+    _nextSample = 0;
+  }
+
+  void stop() {
+    _enabled = false;
+  }
+
+  /** Forget all the samples taken so far */
+  void reset() {
+    _samples.clear();
+    _sampleCount = 0;
+  }
+
+  size_t getSampleCount() {
+    return _sampleCount;
+  }
+
+  inline
+  bool isSampleDue(VM vm);
+
+  /** Take a sample of the given stack, whose front is the running frame */
+  void sample(VM vm, ThreadStack& stack);
+
+  /** Write the samples in the collapsed stacks format */
+  void dumpCollapsed(std::ostream& out);
+private:
+  bool _enabled;
+  std::int64_t _interval;
+  std::int64_t _nextSample;
+
+  size_t _sampleCount;
+  std::unordered_map<std::string, size_t> _samples;
+};
+
+}
+
+#endif // MOZART_PROFILER_DECL_H
@@ -0,0 +1,98 @@
+// Copyright © 2014, Université catholique de Louvain
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// *  Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// *  Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include "mozart.hh"
+
+namespace mozart {
+
+//////////////
+// Profiler //
+//////////////
+
+namespace {
+  void appendFrameLabel(VM vm, std::string& out, StackEntry& entry) {
+    atom_t printName;
+    UnstableNode debugData;
+    Callable(*entry.abstraction).getDebugInfo(vm, printName, debugData);
+
+    if (printName != vm->coreatoms.empty)
+      out.append(printName.contents(), printName.length());
+    else
+      out += "<P>";
+
+    if (entry.debugEntry.valid) {
+      RichNode file = *entry.debugEntry.file;
+      if (file.is<Atom>()) {
+        atom_t fileName = file.as<Atom>().value();
+        out += ' ';
+        out.append(fileName.contents(), fileName.length());
+        out += ':';
+        out += std::to_string(entry.debugEntry.lineNumber);
+      }
+    }
+  }
+}
+
+void Profiler::sample(VM vm, ThreadStack& stack) {
+  StackEntry* frames[MaxDepth];
+  size_t depth = 0;
+  bool truncated = false;
+
+  for (auto iter = stack.begin(); iter != stack.end(); ++iter) {
+    StackEntry& entry = *iter;
+
+    if (entry.isExceptionHandler())
+      continue;
+
+    if (depth == MaxDepth) {
+      truncated = true;
+      break;
+    }
+
+    frames[depth++] = &entry;
+  }
+
+  if (depth == 0)
+    return;
+
+  std::string key;
+  if (truncated)
+    key += "...;";
+
+  for (size_t i = depth; i > 0; i--) {
+    appendFrameLabel(vm, key, *frames[i-1]);
+    if (i > 1)
+      key += ';';
+  }
+
+  _samples[key]++;
+  _sampleCount++;
+}
+
+void Profiler::dumpCollapsed(std::ostream& out) {
+  for (auto& item: _samples)
+    out << item.first << ' ' << item.second << '\n';
+}
+
+}
@@ -189,12 +189,34 @@ public:
     size_t maxGCThreshold;
     size_t gcThresholdTolerance;
     bool autoGC;
+
+    // Scheduling
+    bool spaceAffinity;
   } config;
 
   struct {
     // Memory usage statistics
     size_t activeMemory;
     size_t totalUsedMemory;
+
+    // Garbage collection pauses, in microseconds
+    size_t gcCount;
+    size_t gcLastPause;
+    size_t gcMaxPause;
+    size_t gcTotalPause;
+
+    // Largest heap size seen before a GC, in bytes
+    size_t gcPeakHeap;
+
+    // Space cloning statistics (time in microseconds)
+    size_t spacesCloned;
+    size_t cloneMemory;
+    size_t cloneTime;
+
+    // Space installation statistics (depth is the number of spaces that were
+    // deinstalled and installed, summed over all installations)
+    size_t spaceInstalls;
+    size_t spaceInstallDepth;
   } stats;
 };
 
@@ -54,10 +54,27 @@ PropertyRegistry::PropertyRegistry(VirtualMachineOptions options) {
   computeMaxGCThreshold();
   config.autoGC = true;
 
+  // Scheduling
+
+  config.spaceAffinity = false;
+
   // Memory usage statistics
 
   stats.activeMemory = 0;
   stats.totalUsedMemory = 0;
+
+  stats.gcCount = 0;
+  stats.gcLastPause = 0;
+  stats.gcMaxPause = 0;
+  stats.gcTotalPause = 0;
+  stats.gcPeakHeap = 0;
+
+  stats.spacesCloned = 0;
+  stats.cloneMemory = 0;
+  stats.cloneTime = 0;
+
+  stats.spaceInstalls = 0;
+  stats.spaceInstallDepth = 0;
 }
 
 void PropertyRegistry::registerPredefined(VM vm) {
@@ -73,6 +90,7 @@ void PropertyRegistry::registerPredefined(VM vm) {
     });
   registerConstantProp(vm, "threads.created", 0);
   registerConstantProp(vm, "threads.min", 1);
+  registerReadWriteProp(vm, "threads.spaceAffinity", config.spaceAffinity);
 
   // Print
 
@@ -143,6 +161,24 @@ void PropertyRegistry::registerPredefined(VM vm) {
 
   registerValueProp(vm, "gc.codeCycles", 1); // compatibility, ignored
 
+  registerReadOnlyProp(vm, "gc.count", stats.gcCount);
+  registerReadOnlyProp(vm, "gc.pause.last", stats.gcLastPause);
+  registerReadOnlyProp(vm, "gc.pause.max", stats.gcMaxPause);
+  registerReadOnlyProp(vm, "gc.pause.total", stats.gcTotalPause);
+
+  // The peak also accounts for the current heap, which can be put to 0 to
+  // measure the peak of a specific computation
+  registerReadWriteProp<nativeint>(vm, "gc.peak",
+    [this] (VM vm) {
+      return std::max(stats.gcPeakHeap,
+                      vm->getMemoryManager().getAllocated());
+    },
+    [this] (VM vm, nativeint value) {
+      if (value >= 0)
+        stats.gcPeakHeap = value;
+    }
+  );
+
   // Memory usage statistics - most are irrelevant in Mozart 2
 
   registerReadOnlyProp<nativeint>(vm, "memory.freelist",
@@ -185,7 +221,10 @@ void PropertyRegistry::registerPredefined(VM vm) {
   registerConstantProp(vm, "time.total", 0);
   registerConstantProp(vm, "time.run", 0);
   registerConstantProp(vm, "time.idle", 0);
-  registerConstantProp(vm, "time.copy", 0);
+  registerReadOnlyProp<nativeint>(vm, "time.copy",
+    [] (VM vm) -> nativeint {
+      return vm->getPropertyRegistry().stats.cloneTime / 1000;
+    });
   registerConstantProp(vm, "time.propagate", 0);
   registerConstantProp(vm, "time.gc", 0);
   registerValueProp(vm, "time.detailed", false);
@@ -200,7 +239,10 @@ void PropertyRegistry::registerPredefined(VM vm) {
   // Spaces
 
   registerConstantProp(vm, "spaces.created", 0);
-  registerConstantProp(vm, "spaces.cloned", 0);
+  registerReadOnlyProp(vm, "spaces.cloned", stats.spacesCloned);
+  registerReadOnlyProp(vm, "spaces.clonedMemory", stats.cloneMemory);
+  registerReadOnlyProp(vm, "spaces.installs", stats.spaceInstalls);
+  registerReadOnlyProp(vm, "spaces.installDepth", stats.spaceInstallDepth);
   registerConstantProp(vm, "spaces.committed", 0);
   registerConstantProp(vm, "spaces.failed", 0);
   registerConstantProp(vm, "spaces.succeeded", 0);
@@ -77,6 +77,9 @@ public:
   inline
   UnstableNode cloneSpace(RichNode self, VM vm);
 
+  inline
+  void injectSpace(RichNode self, VM vm, RichNode callable);
+
   inline
   void killSpace(RichNode self, VM vm);
 private:
@@ -129,6 +132,9 @@ public:
   inline
   UnstableNode cloneSpace(VM vm);
 
+  inline
+  void injectSpace(VM vm, RichNode callable);
+
   inline
   void killSpace(VM vm);
 };
@@ -179,6 +185,9 @@ public:
   inline
   UnstableNode cloneSpace(VM vm);
 
+  inline
+  void injectSpace(VM vm, RichNode callable);
+
   inline
   void killSpace(VM vm);
 };
@@ -220,6 +220,18 @@ UnstableNode ReifiedSpace::cloneSpace(RichNode self, VM vm) {
   return ReifiedSpace::build(vm, copy);
 }
 
+void ReifiedSpace::injectSpace(RichNode self, VM vm, RichNode callable) {
+  Space* space = getSpace();
+
+  if (!space->isAdmissible(vm))
+    raise(vm, vm->coreatoms.spaceAdmissible);
+
+  if (space->isFailed())
+    return;
+
+  space->inject(vm, callable);
+}
+
 void ReifiedSpace::killSpace(RichNode self, VM vm) {
   Space* space = getSpace();
 
@@ -258,6 +270,10 @@ UnstableNode FailedSpace::cloneSpace(VM vm) {
   return FailedSpace::build(vm);
 }
 
+void FailedSpace::injectSpace(VM vm, RichNode callable) {
+  // nothing to do
+}
+
 void FailedSpace::killSpace(VM vm) {
   // nothing to do
 }
@@ -291,6 +307,10 @@ UnstableNode MergedSpace::cloneSpace(VM vm) {
   raise(vm, vm->coreatoms.spaceMerged);
 }
 
+void MergedSpace::injectSpace(VM vm, RichNode callable) {
+  raise(vm, vm->coreatoms.spaceMerged);
+}
+
 void MergedSpace::killSpace(VM vm) {
   // nothing to do
 }
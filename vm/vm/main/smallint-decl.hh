@@ -128,17 +128,8 @@ public:
   // Miscellaneous
 
   void printReprToStream(VM vm, std::ostream& out, int depth, int width) {
-    if (value() >= 0) {
-      out << value();
-    } else if (value() == min()) {
-      std::ostringstream ss;
-      ss << value();
-      std::string s(ss.str());
-      s[0] = '~';
-      out << s;
-    } else {
-      out << '~' << -value();
-    }
+    char buffer[NumberFormatBufferSize];
+    out.write(buffer, formatInt(buffer, value(), '~'));
   }
 
 private:
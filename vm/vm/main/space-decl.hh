@@ -170,6 +170,9 @@ public:
   inline
   Space* clone(VM vm);
 
+  inline
+  void inject(VM vm, RichNode callable);
+
   inline
   void kill(VM vm);
 
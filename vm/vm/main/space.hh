@@ -285,6 +285,11 @@ Space* Space::clone(VM vm) {
   return vm->cloneSpace(this);
 }
 
+void Space::inject(VM vm, RichNode callable) {
+  clearStatusVar(vm);
+  ozcalls::asyncOzCall(vm, this, callable, *getRootVar());
+}
+
 void Space::kill(VM vm) {
   assert(!isTopLevel());
 
@@ -496,6 +501,13 @@ bool Space::install() {
 bool Space::doInstall(Space* from) {
   Space* ancestor = findCommonAncestor(from);
 
+  auto& stats = vm->getPropertyRegistry().stats;
+  stats.spaceInstalls++;
+  for (Space* s = from; s != ancestor; s = s->getParent())
+    stats.spaceInstallDepth++;
+  for (Space* s = this; s != ancestor; s = s->getParent())
+    stats.spaceInstallDepth++;
+
   from->deinstallTo(ancestor);
   return this->installFrom(ancestor);
 }
@@ -182,6 +182,12 @@ public:
   typedef DefaultStorage<T> Type;
 };
 
+namespace internal {
+  /** Report a node allocated in the heap to the heap profiler */
+  inline
+  void profileAllocation(VM vm, Type type, size_t bytes);
+}
+
 template<class T, class U>
 class AccessorHelper {
 public:
@@ -213,6 +219,7 @@ public:
     type = T::type();
     ActualT* val = new (vm) ActualT(vm, std::forward<Args>(args)...);
     value.init<ActualT*>(vm, val);
+    internal::profileAllocation(vm, type, sizeof(ActualT));
   }
 
   static T& get(MemWord value) {
@@ -247,6 +254,7 @@ public:
     // Fill in output parameters
     type = T::type();
     value.init<T*>(vm, impl);
+    internal::profileAllocation(vm, type, sizeof(T) + elemCount*sizeof(E));
   }
 
   static T& get(MemWord value) {
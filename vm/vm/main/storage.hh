@@ -33,6 +33,12 @@
 
 namespace mozart {
 
+namespace internal {
+  void profileAllocation(VM vm, Type type, size_t bytes) {
+    vm->getHeapProfiler().recordAllocation(vm, type, bytes);
+  }
+}
+
 ////////////////////////////
 // ImplAndCleanupListNode //
 ////////////////////////////
@@ -60,6 +60,13 @@ public:
     return false;
   }
 
+  /**
+   * Remove and return the first thread of the given space among the first
+   * `window` entries of this queue, or nullptr if there is none
+   */
+  inline
+  Runnable* popInSpace(Space* space, size_t window);
+
   inline
   void dump();
 };
@@ -71,12 +78,19 @@ public:
 const int HiToMiddlePriorityRatio = 10;
 const int MiddleToLowPriorityRatio = 10;
 
+// Space affinity: how far ahead in a queue we look for a thread of the
+// installed space, and how many times in a row the front of a queue may be
+// bypassed before it is served anyway (so that no thread is starved)
+const size_t SpaceAffinityWindow = 16;
+const int MaxSpaceAffinityStreak = 8;
+
 class ThreadPool {
 public:
   ThreadPool() {
     remainings[tpLow] = 0;
     remainings[tpMiddle] = 0;
     remainings[tpHi] = 0;
+    affinityStreak = 0;
   }
 
   bool empty() {
@@ -112,8 +126,13 @@ public:
     queues[tpHi].gCollect(gc);
   }
 
+  /**
+   * Pop the next thread to run.
+   * If preferredSpace is not null, a thread of that space is preferred within
+   * the selected priority class, so that the VM need not reinstall spaces.
+   */
   inline
-  Runnable* popNext();
+  Runnable* popNext(Space* preferredSpace = nullptr);
 
   void dump() {
     queues[tpLow].dump();
@@ -126,7 +145,7 @@ private:
   }
 
   inline
-  Runnable* popNext(ThreadPriority priority);
+  Runnable* popNext(ThreadPriority priority, Space* preferredSpace);
 
   bool isScheduled(Runnable* thread) {
     return queues[tpMiddle].isScheduled(thread) ||
@@ -136,6 +155,7 @@ private:
 
   ThreadQueue queues[tpCount];
   int remainings[tpCount];
+  int affinityStreak;
 };
 
 }
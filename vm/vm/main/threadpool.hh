@@ -40,6 +40,20 @@ void ThreadQueue::gCollect(GC gc) {
   }
 }
 
+Runnable* ThreadQueue::popInSpace(Space* space, size_t window) {
+  size_t index = 0;
+  for (auto iterator = c.begin(); iterator != c.end() && index < window;
+       ++iterator, ++index) {
+    Runnable* runnable = *iterator;
+    if (runnable->getSpace() == space) {
+      c.erase(iterator);
+      return runnable;
+    }
+  }
+
+  return nullptr;
+}
+
 void ThreadQueue::dump() {
   for (auto iterator = c.begin(); iterator != c.end(); iterator++) {
     Runnable* runnable = *iterator;
@@ -51,12 +65,12 @@ void ThreadQueue::dump() {
 // ThreadPool //
 ////////////////
 
-Runnable* ThreadPool::popNext() {
+Runnable* ThreadPool::popNext(Space* preferredSpace) {
   do {
     // While remainings[tpHi] > 0, return the first Hi-priority thread
     if (!queues[tpHi].empty() && remainings[tpHi] > 0) {
       remainings[tpHi]--;
-      return popNext(tpHi);
+      return popNext(tpHi, preferredSpace);
     }
 
     // Reset remainings[tpHi] for subsequent calls
@@ -65,7 +79,7 @@ Runnable* ThreadPool::popNext() {
     // While remainings[tpMiddle] > 0, return the first Middle-priority thread
     if (!queues[tpMiddle].empty() && remainings[tpMiddle] > 0) {
       remainings[tpMiddle]--;
-      return popNext(tpMiddle);
+      return popNext(tpMiddle, preferredSpace);
     }
 
     // Reset remainings[tpMiddle] for subsequent calls
@@ -73,16 +87,32 @@ Runnable* ThreadPool::popNext() {
 
     // remainings[tpLow] is not used, always return the first Low-priority thread
     if (!queues[tpLow].empty()) {
-      return popNext(tpLow);
+      return popNext(tpLow, preferredSpace);
     }
   } while (!empty()); // might not be empty if all remainings were 0
 
   return nullptr;
 }
 
-Runnable* ThreadPool::popNext(ThreadPriority priority) {
-  Runnable* result = queues[priority].front();
-  queues[priority].pop();
+Runnable* ThreadPool::popNext(ThreadPriority priority,
+                              Space* preferredSpace) {
+  ThreadQueue& queue = queues[priority];
+
+  if (preferredSpace != nullptr) {
+    if (queue.front()->getSpace() != preferredSpace &&
+        affinityStreak < MaxSpaceAffinityStreak) {
+      Runnable* result = queue.popInSpace(preferredSpace, SpaceAffinityWindow);
+      if (result != nullptr) {
+        affinityStreak++;
+        return result;
+      }
+    }
+
+    affinityStreak = 0;
+  }
+
+  Runnable* result = queue.front();
+  queue.pop();
   return result;
 }
 
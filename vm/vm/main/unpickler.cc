@@ -34,7 +34,16 @@ namespace {
 
 class Unpickler {
 public:
-  Unpickler(VM vm, std::istream& input): vm(vm), input(input) {
+  Unpickler(VM vm, std::istream& input):
+    vm(vm), input(input), malformed(false) {
+  }
+
+  /**
+   * Whether a value could not be read. Reading goes on after it, since the
+   * input is still well delimited, but the result must be discarded.
+   */
+  bool isMalformed() {
+    return malformed;
   }
 
   /** Top-level unpickle function */
@@ -93,26 +102,33 @@ public:
 
 private:
   UnstableNode readIntValue() {
-    std::string str = readString();
-    char* end = nullptr;
-    errno = 0; // reset errno since we need to know if strtoll() overflowed
-    long long intResult = std::strtoll(str.c_str(), &end, 10);
-    assert(*end == '\0' && "bad integer string");
-    nativeint value = (nativeint) intResult;
-    if ((value == SmallInt::min() || value == SmallInt::max()) &&
-        errno == ERANGE) { // Overflow
-      return BigInt::build(vm, str);
-    } else {
-      return SmallInt::build(vm, value);
-    }
+    return readShortString(
+      [this] (const char* begin, const char* end) -> UnstableNode {
+        nativeint value;
+        auto status = parseInt(begin, end, value);
+        if (status == ParseIntResult::invalid) {
+          malformed = true;
+          return build(vm, unit);
+        } else if (status == ParseIntResult::overflow) {
+          return BigInt::build(vm, std::string(begin, end));
+        } else {
+          return SmallInt::build(vm, value);
+        }
+      }
+    );
   }
 
   UnstableNode readFloatValue() {
-    std::string str = readString();
-    char* end = nullptr;
-    double doubleResult = std::strtod(str.c_str(), &end);
-    assert(*end == '\0' && "bad float string");
-    return build(vm, doubleResult);
+    return readShortString(
+      [this] (const char* begin, const char* end) -> UnstableNode {
+        double value;
+        if (!parseFloat(begin, end, value)) {
+          malformed = true;
+          return build(vm, unit);
+        }
+        return build(vm, value);
+      }
+    );
   }
 
   UnstableNode readBooleanValue() {
@@ -324,6 +340,24 @@ private:
     return result;
   }
 
+  /**
+   * Read a string that is usually short, such as a number, and apply f to
+   * its chars, without allocating when it is short
+   */
+  template <class F>
+  UnstableNode readShortString(const F& f) {
+    size_t length = readSize();
+    char buffer[64];
+    if (length <= sizeof(buffer)) {
+      read(buffer, length);
+      return f(buffer, buffer + length);
+    } else {
+      std::string str(length, '\0');
+      read(&str[0], length);
+      return f(str.data(), str.data() + length);
+    }
+  }
+
   /** Read an atom */
   atom_t readAtom() {
     std::string str = readString();
@@ -378,6 +412,7 @@ private:
   VM vm;
   std::istream& input;
   std::vector<UnstableNode> nodes;
+  bool malformed;
 };
 
 } // namespace <anonymous>
@@ -386,9 +421,25 @@ private:
 // Entry point //
 /////////////////
 
-UnstableNode unpickle(VM vm, std::istream& input) {
+bool tryUnpickle(VM vm, std::istream& input, UnstableNode& result) {
   Unpickler unpickler(vm, input);
-  return unpickler.unpickle();
+  result = unpickler.unpickle();
+  return !unpickler.isMalformed();
+}
+
+UnstableNode unpickle(VM vm, std::istream& input) {
+  UnstableNode result;
+  if (!tryUnpickle(vm, input, result))
+    raiseMalformedPickle(vm);
+  return result;
+}
+
+void raiseMalformedPickle(VM vm) {
+  raiseError(vm, "dp",
+    "generic",
+    "unpickle:malformed",
+    "Malformed value found during unpickling",
+    buildNil(vm));
 }
 
 } // namespace mozart
@@ -31,8 +31,21 @@
 
 namespace mozart {
 
+/**
+ * Unpickle a value from input
+ * Raises a dp(generic 'unpickle:malformed' ...) error if a value is malformed,
+ * e.g., a number that cannot be parsed.
+ */
 UnstableNode unpickle(VM vm, std::istream& input);
 
+/**
+ * Unpickle a value from input, without raising on malformed values
+ * @return false if a value was malformed, in which case result is unusable
+ */
+bool tryUnpickle(VM vm, std::istream& input, UnstableNode& result);
+
+void raiseMalformedPickle(VM vm);
+
 }
 
 #endif // MOZART_UNPICKLER_H
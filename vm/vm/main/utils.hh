@@ -283,68 +283,21 @@ using IntToStrBuffer = char[getIntToStrBufferSize()];
 
 inline
 size_t intToStrBuffer(IntToStrBuffer buffer, nativeint value) {
-  char buffer0[getIntToStrBufferSize()];
-  auto length = std::snprintf(buffer0, getIntToStrBufferSize(), "%td", value);
-  assert(length >= 0 && (size_t) length < getIntToStrBufferSize());
-
-  std::copy(buffer0, buffer0 + getIntToStrBufferSize(), buffer);
-  return (size_t) length;
+  auto length = formatInt(buffer, value);
+  buffer[length] = '\0';
+  return length;
 }
 
 inline
 constexpr size_t getFloatToStrBufferSize() {
-  return 32;
+  return NumberFormatBufferSize;
 }
 
 using FloatToStrBuffer = char[getFloatToStrBufferSize()];
 
 inline
 size_t floatToStrBuffer(FloatToStrBuffer buffer, double value) {
-  char buffer0[getFloatToStrBufferSize()];
-  auto length0 = std::snprintf(buffer0, sizeof(buffer0), "%.5g", value);
-  assert(length0 >= 0 && (size_t) length0 < getFloatToStrBufferSize());
-
-  size_t length = 0;
-  bool hasDot = false, hasDigit = false;
-
-  for (size_t i = 0; i < (size_t) length0; ++i) {
-    switch (buffer0[i]) {
-      case '+':
-        continue;
-
-      case '-':
-        break;
-
-      case 'e':
-        if (!hasDot)
-          buffer[length++] = '.';
-        if (!hasDigit)
-          buffer[length++] = '0';
-        hasDigit = hasDot = true;
-        break;
-
-      case '.':
-        hasDot = true;
-        break;
-
-      case '0': case '1': case '2': case '3': case '4':
-      case '5': case '6': case '7': case '8': case '9':
-        if (hasDot)
-          hasDigit = true;
-        break;
-
-      default:
-        break;
-    }
-
-    buffer[length++] = buffer0[i];
-  }
-
-  if (!hasDot)
-    buffer[length++] = '.';
-  if (!hasDigit)
-    buffer[length++] = '0';
-
+  auto length = formatFloat(buffer, value);
   buffer[length] = '\0';
   return length;
 }
@@ -28,11 +28,15 @@
 #include <cstdlib>
 #include <forward_list>
 #include <atomic>
+#include <vector>
 
 #include "core-forward-decl.hh"
 
 #include "memmanager.hh"
 
+#include "alarms-decl.hh"
+#include "heapprofiler-decl.hh"
+#include "profiler-decl.hh"
 #include "store-decl.hh"
 #include "threadpool-decl.hh"
 #include "gcollect-decl.hh"
@@ -147,14 +151,6 @@ public:
   };
 
   typedef std::pair<RunExitCode, std::int64_t> run_return_type;
-private:
-  struct AlarmRecord {
-    AlarmRecord(std::int64_t expiration, StableNode* wakeable):
-      expiration(expiration), wakeable(wakeable) {}
-
-    std::int64_t expiration;
-    StableNode* wakeable;
-  };
 public:
   inline
   VirtualMachine(VirtualMachineEnvironment& environment,
@@ -283,6 +279,19 @@ public:
     return _pickleTypesRecord;
   }
 
+  Profiler& getProfiler() {
+    return _profiler;
+  }
+
+  HeapProfiler& getHeapProfiler() {
+    return _heapProfiler;
+  }
+
+  // Called by the GC: the dictionary has entries to post after the GC
+  void enqueueFinalization(WeakDictionary* dict) {
+    _finalizationQueue.push_back(dict);
+  }
+
 public:
   inline
   std::shared_ptr<BigIntImplem> newBigIntImplem(nativeint value);
@@ -418,9 +427,12 @@ private:
   GarbageCollector gc;
   SpaceCloner sc;
 
-  VMAllocatedList<AlarmRecord> _alarms;
+  AlarmWheel _alarms;
+  Profiler _profiler;
+  HeapProfiler _heapProfiler;
   StableNode* _pickleTypesRecord;
   std::forward_list<std::weak_ptr<StableNode*>> _protectedNodes;
+  std::vector<WeakDictionary*> _finalizationQueue;
 
   // Flags set externally for preemption etc.
   // TODO Use atomic data types
@@ -40,19 +40,19 @@ VirtualMachine::run_return_type VirtualMachine::run() {
     }
 
     // Trigger alarms
-    std::int64_t now = getReferenceTime();
-    while (!_alarms.empty() && (_alarms.front().expiration <= now)) {
+    _alarms.advance(this, getReferenceTime());
+    while (_alarms.hasExpired()) {
       getTopLevelSpace()->install();
 
-      Wakeable(*_alarms.front().wakeable).wakeUp(this);
-
-      _alarms.remove_front(this);
+      Wakeable(*_alarms.popExpired(this)).wakeUp(this);
     }
 
-    // Select a thread
+    // Select a thread, preferring one of the installed space if asked to
+    Space* preferredSpace = getPropertyRegistry().config.spaceAffinity ?
+      getCurrentSpace() : nullptr;
     Runnable* currentThread;
     do {
-      currentThread = threadPool.popNext();
+      currentThread = threadPool.popNext(preferredSpace);
     } while (currentThread != nullptr && currentThread->isTerminated());
 
     // When there is no runnable thread left, return to the external world
@@ -86,7 +86,7 @@ VirtualMachine::run_return_type VirtualMachine::run() {
   else if (_alarms.empty())
     return run_return_type(recNeverInvokeAgain, 0);
   else
-    return run_return_type(recInvokeAgainLater, _alarms.front().expiration);
+    return run_return_type(recInvokeAgainLater, _alarms.nextExpiration());
 }
 
 }
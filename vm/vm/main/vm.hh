@@ -27,6 +27,10 @@
 
 #include "mozartcore.hh"
 
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+
 #ifndef MOZART_GENERATOR
 
 namespace mozart {
@@ -119,7 +123,28 @@ void VirtualMachine::setCurrentSpace(Space* space) {
 }
 
 Space* VirtualMachine::cloneSpace(Space* space) {
-  return sc.doCloneSpace(space);
+  // Heap growth, including the blocks carved for the free lists and the
+  // big blocks, which are not in the heap proper
+  auto heapSize = [this] () -> std::int64_t {
+    return (std::int64_t) (memoryManager.getAllocated() +
+                           memoryManager.getAllocatedInBigBlocks());
+  };
+
+  std::int64_t memoryBefore = heapSize();
+  auto start = std::chrono::steady_clock::now();
+
+  Space* result = sc.doCloneSpace(space);
+
+  // The clone can free big blocks, so the difference can be negative
+  std::int64_t memoryDelta = heapSize() - memoryBefore;
+
+  auto& stats = getPropertyRegistry().stats;
+  stats.spacesCloned++;
+  stats.cloneMemory += (size_t) std::max<std::int64_t>(memoryDelta, 0);
+  stats.cloneTime += std::chrono::duration_cast<std::chrono::microseconds>(
+    std::chrono::steady_clock::now() - start).count();
+
+  return result;
 }
 
 void VirtualMachine::registerBuiltinModule(
@@ -157,13 +182,7 @@ UUID VirtualMachine::genUUID() {
 }
 
 void VirtualMachine::setAlarm(std::int64_t delay, StableNode* wakeable) {
-  std::int64_t expiration = getReferenceTime() + delay;
-
-  auto iter = _alarms.removable_begin();
-  while ((iter != _alarms.removable_end()) && (iter->expiration < expiration))
-    ++iter;
-
-  _alarms.insert_before_new(this, iter, expiration, wakeable);
+  _alarms.insert(this, getReferenceTime() + delay, wakeable);
 }
 
 template <typename T>
@@ -182,9 +201,15 @@ void VirtualMachine::initialize() {
 }
 
 void VirtualMachine::doGC() {
+  auto& stats = getPropertyRegistry().stats;
+
   // Update stats (1)
-  getPropertyRegistry().stats.totalUsedMemory +=
-    memoryManager.getAllocatedOutsideFreeList();
+  stats.totalUsedMemory += memoryManager.getAllocatedOutsideFreeList();
+  stats.gcPeakHeap = std::max(stats.gcPeakHeap, memoryManager.getAllocated());
+
+  auto pauseStart = std::chrono::steady_clock::now();
+
+  _heapProfiler.beginGC(stats.gcCount + 1);
 
   environment.withSecondMemoryManager([this] (MemoryManager& secondMemoryManager) {
     auto cleanupList = acquireCleanupList();
@@ -193,6 +218,22 @@ void VirtualMachine::doGC() {
     secondMemoryManager.releaseExtraAllocs();
   });
 
+  _heapProfiler.endGC();
+
+  // Post the entries of weak dictionaries finalized by this GC
+  for (WeakDictionary* dict : _finalizationQueue)
+    dict->postFinalizedEntries(this);
+  _finalizationQueue.clear();
+
+  // Pause statistics
+  size_t pause = std::chrono::duration_cast<std::chrono::microseconds>(
+    std::chrono::steady_clock::now() - pauseStart).count();
+  stats.gcCount++;
+  stats.gcLastPause = pause;
+  stats.gcTotalPause += pause;
+  if (pause > stats.gcMaxPause)
+    stats.gcMaxPause = pause;
+
   // Handle the GC watcher
   UnstableNode watcher;
   if (getPropertyRegistry().get(this, "gc.watcher", watcher)) {
@@ -276,8 +317,6 @@ void VirtualMachine::adjustHeapSize() {
 }
 
 void VirtualMachine::startGC(GC gc, MemoryManager& secondMemoryManager) {
-  VMAllocatedList<AlarmRecord> alarms = std::move(_alarms);
-
   // Swap spaces
   memoryManager.swap(secondMemoryManager);
   memoryManager.init(this);
@@ -285,7 +324,6 @@ void VirtualMachine::startGC(GC gc, MemoryManager& secondMemoryManager) {
   // Forget lists of things
   atomTable = AtomTable();
   aliveThreads = RunnableList();
-  _alarms = VMAllocatedList<AlarmRecord>();
   rootGlobalNode = nullptr;
 
   // Reinitialize the VM
@@ -307,10 +345,7 @@ void VirtualMachine::startGC(GC gc, MemoryManager& secondMemoryManager) {
   gcProtectedNodes(gc);
 
   // Pending alarms
-  for (auto iter = alarms.begin(); iter != alarms.end(); ++iter) {
-    _alarms.push_back_new(this, iter->expiration, iter->wakeable);
-    gc->copyStableRef(_alarms.back().wakeable, _alarms.back().wakeable);
-  }
+  _alarms.gCollect(gc);
 
   // Pickle types record
   gc->copyStableRef(_pickleTypesRecord, _pickleTypesRecord);
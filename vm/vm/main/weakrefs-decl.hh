@@ -29,6 +29,8 @@
 
 #include <typeinfo>
 
+#include "dictionary-decl.hh"
+
 namespace mozart {
 
 ///////////////////
@@ -67,6 +69,140 @@ private:
 #include "WeakReference-implem-decl-after.hh"
 #endif
 
+////////////////////
+// WeakDictionary //
+////////////////////
+
+#ifndef MOZART_GENERATOR
+#include "WeakDictionary-implem-decl.hh"
+#endif
+
+/**
+ * Dictionary whose entries are dropped when their values die
+ * Values are held through weak references. When the GC finds a value that is
+ * only reachable through weak dictionaries, it keeps it alive for one more
+ * cycle, and the entry is removed and sent as Key#Value on the notification
+ * stream of the dictionary right after the GC.
+ */
+class WeakDictionary: public DataType<WeakDictionary>, public WithHome {
+public:
+  static atom_t getTypeAtom(VM vm) {
+    return vm->getAtom("weakDictionary");
+  }
+
+  inline
+  WeakDictionary(VM vm, UnstableNode& stream);
+
+  inline
+  WeakDictionary(VM vm, GR gr, WeakDictionary& from);
+
+public:
+  // Dottable interface
+
+  inline
+  bool lookupFeature(VM vm, RichNode feature,
+                     nullable<UnstableNode&> value);
+
+  inline
+  bool lookupFeature(VM vm, nativeint feature,
+                     nullable<UnstableNode&> value);
+
+public:
+  // DotAssignable interface
+
+  void dotAssign(VM vm, RichNode feature, RichNode newValue) {
+    return put(vm, feature, newValue);
+  }
+
+  UnstableNode dotExchange(RichNode self, VM vm, RichNode feature,
+                           RichNode newValue) {
+    return exchange(self, vm, feature, newValue);
+  }
+
+public:
+  // Operations
+
+  inline
+  bool isEmpty(VM vm);
+
+  inline
+  bool member(VM vm, RichNode feature);
+
+  inline
+  UnstableNode get(RichNode self, VM vm, RichNode feature);
+
+  inline
+  UnstableNode condGet(VM vm, RichNode feature, RichNode defaultValue);
+
+  inline
+  void put(VM vm, RichNode feature, RichNode newValue);
+
+  inline
+  UnstableNode exchange(RichNode self, VM vm, RichNode feature,
+                        RichNode newValue);
+
+  inline
+  UnstableNode condExchange(VM vm, RichNode feature,
+                            RichNode defaultValue, RichNode newValue);
+
+  inline
+  void remove(VM vm, RichNode feature);
+
+  inline
+  void removeAll(VM vm);
+
+  inline
+  UnstableNode keys(VM vm);
+
+  inline
+  UnstableNode entries(VM vm);
+
+  inline
+  UnstableNode items(VM vm);
+
+  // Stop sending notifications, dead entries are then silently dropped
+  inline
+  void close(VM vm);
+
+public:
+  // Finalization
+
+  /**
+   * Called by the GC once everything reachable has been copied
+   * Dead values are resurrected into the list of finalized entries.
+   */
+  inline
+  void finalizeDeadEntries(GR gr);
+
+  /**
+   * Called after the GC: remove the finalized entries and post them on the
+   * notification stream
+   */
+  inline
+  void postFinalizedEntries(VM vm);
+
+public:
+  // Miscellaneous
+
+  void printReprToStream(VM vm, std::ostream& out, int depth, int width) {
+    out << "<WeakDictionary>";
+  }
+
+private:
+  // Returns nullptr if there is no alive value for this feature
+  inline
+  StableNode* lookupAlive(VM vm, RichNode feature);
+
+  NodeDictionary _dict; // feature -> WeakReference to the value
+  UnstableNode _stream;
+  UnstableNode _finalized; // list of Key#Value, posted after the GC
+  bool _closed;
+};
+
+#ifndef MOZART_GENERATOR
+#include "WeakDictionary-implem-decl-after.hh"
+#endif
+
 }
 
 #endif // MOZART_WEAKREFS_DECL_H
@@ -41,6 +41,229 @@ void WeakReference::create(StableNode*& self, VM vm, GR gr, WeakReference from)
   gr->copyWeakStableRef(self, from.getUnderlying());
 }
 
+////////////////////
+// WeakDictionary //
+////////////////////
+
+#include "WeakDictionary-implem.hh"
+
+WeakDictionary::WeakDictionary(VM vm, UnstableNode& stream):
+  WithHome(vm), _closed(false) {
+
+  _stream = ReadOnlyVariable::build(vm);
+  stream.copy(vm, _stream);
+  _finalized = buildNil(vm);
+}
+
+WeakDictionary::WeakDictionary(VM vm, GR gr, WeakDictionary& from):
+  WithHome(vm, gr, from), _dict(gr, from._dict), _closed(from._closed) {
+
+  gr->copyUnstableNode(_stream, from._stream);
+  gr->copyUnstableNode(_finalized, from._finalized);
+
+  if (gr->kind() == GraphReplicator::grkGarbageCollection)
+    gr->registerWeakDictionary(this);
+}
+
+StableNode* WeakDictionary::lookupAlive(VM vm, RichNode feature) {
+  UnstableNode* weakRef = nullptr;
+  if (_dict.lookup(vm, feature, weakRef))
+    return RichNode(*weakRef).as<WeakReference>().getUnderlying();
+  else
+    return nullptr;
+}
+
+bool WeakDictionary::lookupFeature(VM vm, RichNode feature,
+                                   nullable<UnstableNode&> value) {
+  StableNode* underlying = lookupAlive(vm, feature);
+  if (underlying == nullptr)
+    return false;
+
+  if (value.isDefined())
+    value.get().copy(vm, *underlying);
+  return true;
+}
+
+bool WeakDictionary::lookupFeature(VM vm, nativeint feature,
+                                   nullable<UnstableNode&> value) {
+  UnstableNode featureNode = mozart::build(vm, feature);
+  return lookupFeature(vm, featureNode, value);
+}
+
+bool WeakDictionary::isEmpty(VM vm) {
+  return _dict.foldRight<bool>(true,
+    [] (UnstableNode& key, UnstableNode& weakRef, bool previous) -> bool {
+      return previous &&
+        RichNode(weakRef).as<WeakReference>().getUnderlying() == nullptr;
+    }
+  );
+}
+
+bool WeakDictionary::member(VM vm, RichNode feature) {
+  return lookupAlive(vm, feature) != nullptr;
+}
+
+UnstableNode WeakDictionary::get(RichNode self, VM vm, RichNode feature) {
+  StableNode* underlying = lookupAlive(vm, feature);
+  if (underlying == nullptr)
+    raiseKernelError(vm, "dict", self, feature);
+
+  return { vm, *underlying };
+}
+
+UnstableNode WeakDictionary::condGet(VM vm, RichNode feature,
+                                     RichNode defaultValue) {
+  StableNode* underlying = lookupAlive(vm, feature);
+  if (underlying == nullptr)
+    return { vm, defaultValue };
+  else
+    return { vm, *underlying };
+}
+
+void WeakDictionary::put(VM vm, RichNode feature, RichNode newValue) {
+  if (!isHomedInCurrentSpace(vm))
+    return raise(vm, "globalState", "weakDictionary");
+
+  requireFeature(vm, feature);
+
+  UnstableNode* weakRef = nullptr;
+  _dict.lookupOrCreate(vm, feature, weakRef);
+
+  weakRef->copy(vm, WeakReference::build(vm, newValue.getStableRef(vm)));
+}
+
+UnstableNode WeakDictionary::exchange(RichNode self, VM vm, RichNode feature,
+                                      RichNode newValue) {
+  if (!isHomedInCurrentSpace(vm))
+    raise(vm, "globalState", "weakDictionary");
+
+  StableNode* underlying = lookupAlive(vm, feature);
+  if (underlying == nullptr)
+    raiseKernelError(vm, "dict", self, feature);
+
+  UnstableNode oldValue(vm, *underlying);
+  put(vm, feature, newValue);
+  return oldValue;
+}
+
+UnstableNode WeakDictionary::condExchange(VM vm, RichNode feature,
+                                          RichNode defaultValue,
+                                          RichNode newValue) {
+  if (!isHomedInCurrentSpace(vm))
+    raise(vm, "globalState", "weakDictionary");
+
+  StableNode* underlying = lookupAlive(vm, feature);
+  UnstableNode oldValue = (underlying == nullptr) ?
+    UnstableNode(vm, defaultValue) : UnstableNode(vm, *underlying);
+  put(vm, feature, newValue);
+  return oldValue;
+}
+
+void WeakDictionary::remove(VM vm, RichNode feature) {
+  if (!isHomedInCurrentSpace(vm))
+    return raise(vm, "globalState", "weakDictionary");
+
+  requireFeature(vm, feature);
+
+  _dict.remove(vm, feature);
+}
+
+void WeakDictionary::removeAll(VM vm) {
+  if (!isHomedInCurrentSpace(vm))
+    return raise(vm, "globalState", "weakDictionary");
+
+  _dict.removeAll(vm);
+}
+
+UnstableNode WeakDictionary::keys(VM vm) {
+  return _dict.foldRight<UnstableNode>(buildNil(vm),
+    [vm] (UnstableNode& key, UnstableNode& weakRef,
+          UnstableNode previous) -> UnstableNode {
+      if (RichNode(weakRef).as<WeakReference>().getUnderlying() == nullptr)
+        return previous;
+      return buildCons(vm, key, std::move(previous));
+    }
+  );
+}
+
+UnstableNode WeakDictionary::entries(VM vm) {
+  return _dict.foldRight<UnstableNode>(buildNil(vm),
+    [vm] (UnstableNode& key, UnstableNode& weakRef,
+          UnstableNode previous) -> UnstableNode {
+      StableNode* value = RichNode(weakRef).as<WeakReference>().getUnderlying();
+      if (value == nullptr)
+        return previous;
+      return buildCons(vm,
+                       buildTuple(vm, vm->coreatoms.sharp, key, *value),
+                       std::move(previous));
+    }
+  );
+}
+
+UnstableNode WeakDictionary::items(VM vm) {
+  return _dict.foldRight<UnstableNode>(buildNil(vm),
+    [vm] (UnstableNode& key, UnstableNode& weakRef,
+          UnstableNode previous) -> UnstableNode {
+      StableNode* value = RichNode(weakRef).as<WeakReference>().getUnderlying();
+      if (value == nullptr)
+        return previous;
+      return buildCons(vm, *value, std::move(previous));
+    }
+  );
+}
+
+void WeakDictionary::close(VM vm) {
+  _closed = true;
+  _stream = mozart::build(vm, unit);
+}
+
+void WeakDictionary::finalizeDeadEntries(GR gr) {
+  VM vm = gr->vm;
+
+  bool hasFinalized = _dict.foldRight<bool>(false,
+    [this, vm, gr] (UnstableNode& key, UnstableNode& weakRef,
+                   bool previous) -> bool {
+      StableNode* value = RichNode(weakRef).as<WeakReference>().getUnderlying();
+      if (value == nullptr || gr->isReplicated(value))
+        return previous;
+
+      // The value is dead: keep it alive until it is posted on the stream
+      UnstableNode entry = Tuple::build(vm, 2, vm->coreatoms.sharp);
+      auto tuple = RichNode(entry).as<Tuple>();
+      tuple.getElement(0)->init(vm, key);
+      if (_closed)
+        tuple.getElement(1)->init(vm, mozart::build(vm, unit));
+      else
+        gr->copyStableNode(*tuple.getElement(1), *value);
+
+      _finalized = buildCons(vm, std::move(entry), std::move(_finalized));
+      return true;
+    }
+  );
+
+  if (hasFinalized)
+    vm->enqueueFinalization(this);
+}
+
+void WeakDictionary::postFinalizedEntries(VM vm) {
+  UnstableNode finalized = std::move(_finalized);
+  _finalized = buildNil(vm);
+
+  bool notify = !_closed && isHomedInCurrentSpace(vm);
+
+  RichNode list = finalized;
+  while (list.is<Cons>()) {
+    auto cons = list.as<Cons>();
+    RichNode entry = *cons.getHead();
+
+    _dict.remove(vm, *entry.as<Tuple>().getElement(0));
+    if (notify)
+      sendToReadOnlyStream(vm, _stream, entry);
+
+    list = *cons.getTail();
+  }
+}
+
 }
 
 #endif // MOZART_GENERATOR
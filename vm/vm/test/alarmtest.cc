@@ -0,0 +1,104 @@
+#include "mozart.hh"
+#include <gtest/gtest.h>
+#include "testutils.hh"
+
+#include <vector>
+
+using namespace mozart;
+
+class AlarmTest : public MozartTest {
+protected:
+  struct Alarm {
+    std::int64_t expiration;
+    ProtectedNode variable;
+  };
+
+  Alarm setAlarm(std::int64_t delay) {
+    UnstableNode variable = Variable::build(vm, vm->getTopLevelSpace());
+    vm->setAlarm(delay, RichNode(variable).getStableRef(vm));
+    return { vm->getReferenceTime() + delay, vm->protect(variable) };
+  }
+
+  static bool isTriggered(const Alarm& alarm) {
+    return RichNode(*alarm.variable).is<Unit>();
+  }
+
+  void expectTriggeredExactlyUntil(const std::vector<Alarm>& alarms,
+                                   std::int64_t now) {
+    for (auto& alarm : alarms)
+      EXPECT_EQ(alarm.expiration <= now, isTriggered(alarm));
+  }
+};
+
+TEST_F(AlarmTest, TriggerInTime) {
+  vm->setReferenceTime(1000);
+
+  std::vector<Alarm> alarms;
+  for (std::int64_t delay : { 5000, 10, 1000000, 100, 10 })
+    alarms.push_back(setAlarm(delay));
+
+  auto result = vm->run();
+  EXPECT_EQ(VirtualMachine::recInvokeAgainLater, result.first);
+  EXPECT_EQ(1010, result.second);
+  expectTriggeredExactlyUntil(alarms, 1000);
+
+  for (std::int64_t now : { 1009, 1010, 1099, 1100, 5999, 1001000 }) {
+    vm->setReferenceTime(now);
+    result = vm->run();
+    expectTriggeredExactlyUntil(alarms, now);
+
+    if (now < 1001000) {
+      EXPECT_EQ(VirtualMachine::recInvokeAgainLater, result.first);
+      EXPECT_LT(now, result.second);
+    }
+  }
+
+  EXPECT_EQ(VirtualMachine::recNeverInvokeAgain, result.first);
+}
+
+TEST_F(AlarmTest, SurviveGC) {
+  vm->setReferenceTime(50);
+
+  std::vector<Alarm> alarms;
+  for (std::int64_t delay : { 1, 63, 64, 4095, 4096, 300000 })
+    alarms.push_back(setAlarm(delay));
+
+  vm->requestGC();
+  vm->run();
+  expectTriggeredExactlyUntil(alarms, 50);
+
+  vm->setReferenceTime(4200);
+  vm->requestGC();
+  vm->run();
+  expectTriggeredExactlyUntil(alarms, 4200);
+
+  vm->setReferenceTime(300050);
+  vm->requestGC();
+  vm->run();
+  expectTriggeredExactlyUntil(alarms, 300050);
+}
+
+TEST_F(AlarmTest, FollowNextExpiration) {
+  vm->setReferenceTime(123456);
+
+  std::vector<Alarm> alarms;
+  for (std::int64_t i = 0; i < 2000; i++)
+    alarms.push_back(setAlarm(1 + (i * 7919) % 100000));
+
+  std::int64_t now = 123456;
+  while (true) {
+    auto result = vm->run();
+    expectTriggeredExactlyUntil(alarms, now);
+
+    if (result.first == VirtualMachine::recNeverInvokeAgain)
+      break;
+
+    EXPECT_EQ(VirtualMachine::recInvokeAgainLater, result.first);
+    ASSERT_LT(now, result.second);
+    now = result.second;
+    vm->setReferenceTime(now);
+  }
+
+  for (auto& alarm : alarms)
+    EXPECT_TRUE(isTriggered(alarm));
+}
@@ -0,0 +1,57 @@
+#include "mozart.hh"
+
+#include <sstream>
+
+#include <gtest/gtest.h>
+
+#include "testutils.hh"
+
+using namespace mozart;
+
+class CodeAreaTest : public MozartTest {};
+
+TEST_F(CodeAreaTest, PickleQuickened) {
+  // Code as the emulator leaves it after quickening
+  ByteCode codeBlock[] = {
+    OpQuickAddInt, 0, 1, 2,
+    OpPolyInlineAdd, 0, 1, 2,
+    OpQuickUnifyXKAtom, 0, 0,
+    OpPolyInlinePlus1, 0, 1,
+    OpReturn
+  };
+
+  UnstableNode codeArea = CodeArea::build(
+    vm, 1, codeBlock, sizeof(codeBlock), 2, 3, vm->getAtom("test"),
+    build(vm, unit));
+  RichNode(codeArea).as<CodeArea>().getElementsArray()[0].init(
+    vm, build(vm, "atom"));
+
+  std::stringstream buffer;
+  pickle(vm, codeArea, buffer);
+
+  // Unpickle in another VM, which cannot share the original code area
+  auto otherEnvironment = makeTestEnvironment();
+  VirtualMachine otherVirtualMachine(
+    *otherEnvironment, { 10 * MegaBytes, 20 * MegaBytes });
+  VM otherVM = &otherVirtualMachine;
+
+  UnstableNode copy = unpickle(otherVM, buffer);
+  if (EXPECT_IS<CodeArea>(copy)) {
+    size_t arity, Xcount;
+    ProgramCounter start;
+    StaticArray<StableNode> Ks;
+    RichNode(copy).as<CodeArea>().getCodeAreaInfo(
+      otherVM, arity, start, Xcount, Ks);
+
+    ByteCode expected[] = {
+      OpInlineAdd, 0, 1, 2,
+      OpInlineAdd, 0, 1, 2,
+      OpUnifyXK, 0, 0,
+      OpInlinePlus1, 0, 1,
+      OpReturn
+    };
+
+    for (size_t i = 0; i < sizeof(expected) / sizeof(ByteCode); i++)
+      EXPECT_EQ(expected[i], start[i]) << "at index " << i;
+  }
+}
@@ -0,0 +1,188 @@
+#include "mozart.hh"
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "testutils.hh"
+
+using namespace mozart;
+
+class NumConvTest : public MozartTest {
+protected:
+  std::string formatIntStr(nativeint value, char minus = '-') {
+    char buffer[NumberFormatBufferSize];
+    return std::string(buffer, formatInt(buffer, value, minus));
+  }
+
+  std::string formatFloatStr(double value, char minus = '-') {
+    char buffer[NumberFormatBufferSize];
+    return std::string(buffer, formatFloat(buffer, value, minus));
+  }
+
+  ParseIntResult parseIntStr(const char* str, nativeint& result,
+                             int base = 10) {
+    return parseInt(str, str + std::strlen(str), result, base);
+  }
+
+  bool parseFloatStr(const char* str, double& result) {
+    return parseFloat(str, str + std::strlen(str), result);
+  }
+};
+
+TEST_F(NumConvTest, FormatInt) {
+  EXPECT_EQ("0", formatIntStr(0));
+  EXPECT_EQ("42", formatIntStr(42));
+  EXPECT_EQ("-42", formatIntStr(-42));
+  EXPECT_EQ("~42", formatIntStr(-42, '~'));
+  EXPECT_EQ("12300000", formatIntStr(12300000));
+
+  nativeint min = std::numeric_limits<nativeint>::min();
+  nativeint max = std::numeric_limits<nativeint>::max();
+  EXPECT_EQ(std::to_string((long long) min), formatIntStr(min));
+  EXPECT_EQ(std::to_string((long long) max), formatIntStr(max));
+}
+
+TEST_F(NumConvTest, FormatFloat) {
+  EXPECT_EQ("0.0", formatFloatStr(0.0));
+  EXPECT_EQ("-0.0", formatFloatStr(-0.0));
+  EXPECT_EQ("1.0", formatFloatStr(1.0));
+  EXPECT_EQ("0.1", formatFloatStr(0.1));
+  EXPECT_EQ("0.3", formatFloatStr(0.3));
+  EXPECT_EQ("0.6666666666666666", formatFloatStr(2.0 / 3.0));
+  EXPECT_EQ("123456.0", formatFloatStr(123456.0));
+  EXPECT_EQ("1000000000000000.0", formatFloatStr(1.0e15));
+  EXPECT_EQ("1.0e16", formatFloatStr(1.0e16));
+  EXPECT_EQ("1.23e16", formatFloatStr(1.23e16));
+  EXPECT_EQ("0.0001", formatFloatStr(1.0e-4));
+  EXPECT_EQ("1.0e-5", formatFloatStr(1.0e-5));
+  EXPECT_EQ("9.0e125", formatFloatStr(9.0e125));
+  EXPECT_EQ("5.0e-324", formatFloatStr(5.0e-324));
+  EXPECT_EQ("1.7976931348623157e308",
+            formatFloatStr(std::numeric_limits<double>::max()));
+
+  EXPECT_EQ("~3.125", formatFloatStr(-3.125, '~'));
+  EXPECT_EQ("~9.0e~125", formatFloatStr(-9.0e-125, '~'));
+
+  double inf = std::numeric_limits<double>::infinity();
+  EXPECT_EQ("inf", formatFloatStr(inf));
+  EXPECT_EQ("~inf", formatFloatStr(-inf, '~'));
+  EXPECT_EQ("nan", formatFloatStr(std::nan("")));
+}
+
+TEST_F(NumConvTest, ParseInt) {
+  nativeint result;
+
+  EXPECT_EQ(ParseIntResult::success, parseIntStr("0", result));
+  EXPECT_EQ(0, result);
+  EXPECT_EQ(ParseIntResult::success, parseIntStr("12300000", result));
+  EXPECT_EQ(12300000, result);
+  EXPECT_EQ(ParseIntResult::success, parseIntStr("~42", result));
+  EXPECT_EQ(-42, result);
+  EXPECT_EQ(ParseIntResult::success, parseIntStr("-42", result));
+  EXPECT_EQ(-42, result);
+  EXPECT_EQ(ParseIntResult::success, parseIntStr("fF", result, 16));
+  EXPECT_EQ(255, result);
+  EXPECT_EQ(ParseIntResult::success, parseIntStr("101", result, 2));
+  EXPECT_EQ(5, result);
+
+  EXPECT_EQ(ParseIntResult::invalid, parseIntStr("", result));
+  EXPECT_EQ(ParseIntResult::invalid, parseIntStr("~", result));
+  EXPECT_EQ(ParseIntResult::invalid, parseIntStr("+1", result));
+  EXPECT_EQ(ParseIntResult::invalid, parseIntStr("1a", result));
+  EXPECT_EQ(ParseIntResult::invalid, parseIntStr("8", result, 8));
+
+  nativeint min = std::numeric_limits<nativeint>::min();
+  nativeint max = std::numeric_limits<nativeint>::max();
+  std::string minStr = std::to_string((long long) min);
+  std::string maxStr = std::to_string((long long) max);
+
+  EXPECT_EQ(ParseIntResult::success, parseIntStr(minStr.c_str(), result));
+  EXPECT_EQ(min, result);
+  EXPECT_EQ(ParseIntResult::success, parseIntStr(maxStr.c_str(), result));
+  EXPECT_EQ(max, result);
+
+  EXPECT_EQ(ParseIntResult::overflow,
+            parseIntStr((maxStr + "0").c_str(), result));
+  EXPECT_EQ(ParseIntResult::overflow,
+            parseIntStr((minStr + "0").c_str(), result));
+}
+
+TEST_F(NumConvTest, ParseFloat) {
+  double result;
+
+  EXPECT_TRUE(parseFloatStr("1", result));
+  EXPECT_EQ(1.0, result);
+  EXPECT_TRUE(parseFloatStr("1.", result));
+  EXPECT_EQ(1.0, result);
+  EXPECT_TRUE(parseFloatStr(".5", result));
+  EXPECT_EQ(0.5, result);
+  EXPECT_TRUE(parseFloatStr("00012.50", result));
+  EXPECT_EQ(12.5, result);
+  EXPECT_TRUE(parseFloatStr("~1.5e~3", result));
+  EXPECT_EQ(-1.5e-3, result);
+  EXPECT_TRUE(parseFloatStr("-2.5E+2", result));
+  EXPECT_EQ(-250.0, result);
+  EXPECT_TRUE(parseFloatStr("0.1", result));
+  EXPECT_EQ(0.1, result);
+  EXPECT_TRUE(parseFloatStr("1.7976931348623157e308", result));
+  EXPECT_EQ(std::numeric_limits<double>::max(), result);
+
+  EXPECT_TRUE(parseFloatStr("~inf", result));
+  EXPECT_EQ(-std::numeric_limits<double>::infinity(), result);
+  EXPECT_TRUE(parseFloatStr("nan", result));
+  EXPECT_TRUE(std::isnan(result));
+
+  // As written by Double.toString in the bootcompiler
+  EXPECT_TRUE(parseFloatStr("Infinity", result));
+  EXPECT_EQ(std::numeric_limits<double>::infinity(), result);
+  EXPECT_TRUE(parseFloatStr("-Infinity", result));
+  EXPECT_EQ(-std::numeric_limits<double>::infinity(), result);
+  EXPECT_TRUE(parseFloatStr("NaN", result));
+  EXPECT_TRUE(std::isnan(result));
+  EXPECT_TRUE(parseFloatStr("INF", result));
+  EXPECT_EQ(std::numeric_limits<double>::infinity(), result);
+
+  EXPECT_FALSE(parseFloatStr("", result));
+  EXPECT_FALSE(parseFloatStr("~", result));
+  EXPECT_FALSE(parseFloatStr(".", result));
+  EXPECT_FALSE(parseFloatStr("e1", result));
+  EXPECT_FALSE(parseFloatStr("1e", result));
+  EXPECT_FALSE(parseFloatStr("1.0e+", result));
+  EXPECT_FALSE(parseFloatStr("1.0.0", result));
+  EXPECT_FALSE(parseFloatStr(" 1.0", result));
+  EXPECT_FALSE(parseFloatStr("+1.0", result));
+  EXPECT_FALSE(parseFloatStr("0x1p3", result));
+  EXPECT_FALSE(parseFloatStr("infinit", result));
+  EXPECT_FALSE(parseFloatStr("nana", result));
+}
+
+TEST_F(NumConvTest, FloatRoundTrip) {
+  // Random bit patterns cover all exponents, including subnormals
+  std::mt19937_64 random(42);
+
+  for (int i = 0; i < 100000; i++) {
+    std::uint64_t bits = random();
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    if (std::isnan(value))
+      continue;
+
+    for (char minus : { '-', '~' }) {
+      char buffer[NumberFormatBufferSize];
+      size_t length = formatFloat(buffer, value, minus);
+      ASSERT_LT(length, NumberFormatBufferSize);
+
+      double parsed;
+      ASSERT_TRUE(parseFloat(buffer, buffer + length, parsed));
+
+      std::uint64_t parsedBits;
+      std::memcpy(&parsedBits, &parsed, sizeof(parsedBits));
+      EXPECT_EQ(bits, parsedBits);
+    }
+  }
+}
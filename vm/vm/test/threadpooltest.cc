@@ -0,0 +1,132 @@
+#include "mozart.hh"
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "testutils.hh"
+
+using namespace mozart;
+
+class ThreadPoolTest : public MozartTest {
+protected:
+  /** Runnable that is only ever scheduled in the pool under test */
+  class TestRunnable: public Runnable {
+  public:
+    TestRunnable(VM vm, Space* space): Runnable(vm, space) {
+      resume(/* skipSchedule = */ true);
+    }
+
+    TestRunnable(GR gr, TestRunnable& from): Runnable(gr, from) {}
+
+    void run() {
+      terminate();
+    }
+
+    Runnable* gCollect(GC gc) {
+      return new (gc->vm) TestRunnable(gc, *this);
+    }
+
+    Runnable* sClone(SC sc) {
+      return new (sc->vm) TestRunnable(sc, *this);
+    }
+  };
+
+  Space* newSpace(Space* parent) {
+    return new (vm) Space(vm, parent);
+  }
+
+  Runnable* schedule(ThreadPool& pool, Space* space) {
+    Runnable* result = new (vm) TestRunnable(vm, space);
+    pool.schedule(result);
+    return result;
+  }
+};
+
+TEST_F(ThreadPoolTest, SpaceAffinityWindow) {
+  Space* other = newSpace(vm->getTopLevelSpace());
+  Space* preferred = newSpace(vm->getTopLevelSpace());
+
+  ThreadPool pool;
+  std::vector<Runnable*> others;
+  for (size_t i = 0; i < SpaceAffinityWindow - 1; i++)
+    others.push_back(schedule(pool, other));
+  Runnable* inWindow = schedule(pool, preferred);
+  others.push_back(schedule(pool, other));
+  Runnable* beyondWindow = schedule(pool, preferred);
+
+  // The last entry of the window is picked ahead of the front
+  EXPECT_EQ(inWindow, pool.popNext(preferred));
+
+  // The next one is out of the window, so the front runs
+  EXPECT_EQ(others[0], pool.popNext(preferred));
+
+  // Without a preferred space, the queue is FIFO
+  for (size_t i = 1; i < others.size(); i++)
+    EXPECT_EQ(others[i], pool.popNext());
+  EXPECT_EQ(beyondWindow, pool.popNext());
+  EXPECT_TRUE(pool.empty());
+}
+
+TEST_F(ThreadPoolTest, SpaceAffinityStreak) {
+  Space* other = newSpace(vm->getTopLevelSpace());
+  Space* preferred = newSpace(vm->getTopLevelSpace());
+
+  ThreadPool pool;
+  Runnable* front = schedule(pool, other);
+  std::vector<Runnable*> inPreferred;
+  for (int i = 0; i < MaxSpaceAffinityStreak + 2; i++)
+    inPreferred.push_back(schedule(pool, preferred));
+
+  // The front is bypassed at most MaxSpaceAffinityStreak times in a row
+  for (int i = 0; i < MaxSpaceAffinityStreak; i++)
+    EXPECT_EQ(inPreferred[i], pool.popNext(preferred));
+  EXPECT_EQ(front, pool.popNext(preferred));
+
+  // Threads of the preferred space at the front do not count as bypasses
+  for (size_t i = MaxSpaceAffinityStreak; i < inPreferred.size(); i++)
+    EXPECT_EQ(inPreferred[i], pool.popNext(preferred));
+  EXPECT_TRUE(pool.empty());
+}
+
+TEST_F(ThreadPoolTest, SpaceInstallCounters) {
+  auto& stats = vm->getPropertyRegistry().stats;
+  size_t installs = stats.spaceInstalls;
+  size_t depth = stats.spaceInstallDepth;
+
+  Space* top = vm->getTopLevelSpace();
+  Space* a = newSpace(top);
+  Space* b = newSpace(a);
+  Space* c = newSpace(top);
+
+  // top -> a: one space entered
+  EXPECT_TRUE(a->install());
+  EXPECT_EQ(installs + 1, stats.spaceInstalls);
+  EXPECT_EQ(depth + 1, stats.spaceInstallDepth);
+
+  // a -> b: one space entered
+  EXPECT_TRUE(b->install());
+  EXPECT_EQ(installs + 2, stats.spaceInstalls);
+  EXPECT_EQ(depth + 2, stats.spaceInstallDepth);
+
+  // b -> c: two spaces left and one entered
+  EXPECT_TRUE(c->install());
+  EXPECT_EQ(installs + 3, stats.spaceInstalls);
+  EXPECT_EQ(depth + 5, stats.spaceInstallDepth);
+
+  // Installing the current space is free
+  EXPECT_TRUE(c->install());
+  EXPECT_EQ(installs + 3, stats.spaceInstalls);
+  EXPECT_EQ(depth + 5, stats.spaceInstallDepth);
+
+  EXPECT_TRUE(top->install());
+  EXPECT_EQ(installs + 4, stats.spaceInstalls);
+  EXPECT_EQ(depth + 6, stats.spaceInstallDepth);
+
+  // The counters are exposed as properties
+  UnstableNode value;
+  EXPECT_TRUE(vm->getPropertyRegistry().get(vm, "spaces.installs", value));
+  EXPECT_EQ_INT(installs + 4, value);
+  EXPECT_TRUE(vm->getPropertyRegistry().get(vm, "spaces.installDepth", value));
+  EXPECT_EQ_INT(depth + 6, value);
+}